@@ -72,6 +72,14 @@
         <source>commandLineOptionCliHelp</source>
         <translation>displays the help menu to use Linphone with the CLI</translation>
     </message>
+    <message>
+        <source>commandLineOptionCliBatch</source>
+        <translation>read commands on the standard input, one by line, and send them to the running application through one connection. Each command is acknowledged on the standard output</translation>
+    </message>
+    <message>
+        <source>commandLineOptionHeadless</source>
+        <translation>run without windows (only the core, driven by the CLI)</translation>
+    </message>
     <message>
         <source>commandLineDescription</source>
         <translation>send an order to the application towards a command line</translation>
@@ -429,6 +437,14 @@ Server url not configured.</translation>
         <source>cliCommandLineSyntax</source>
         <translation>linphone &quot;&lt;method&gt; ([&lt;argument&gt;=&lt;value&gt;]*)&quot;</translation>
     </message>
+    <message>
+        <source>cliBatchCommandLineSyntax</source>
+        <translation>linphone --cli-batch &lt; &lt;file&gt;</translation>
+    </message>
+    <message>
+        <source>cliBatchDescription</source>
+        <translation>In batch mode, each line is a command (empty lines and lines starting with # are ignored). Each command is acknowledged by one line: OK &lt;line&gt; [&lt;result&gt;] or ERROR &lt;line&gt; &lt;message&gt;.</translation>
+    </message>
     <message>
         <source>commandsName</source>
         <translation>commands list :</translation>
@@ -441,6 +457,22 @@ Server url not configured.</translation>
         <source>callFunctionDescription</source>
         <translation>Initiate a call to the sip-address.</translation>
     </message>
+    <message>
+        <source>getCallsFunctionDescription</source>
+        <translation>Return the active calls with their state and latest stats, in JSON.</translation>
+    </message>
+    <message>
+        <source>getRegistrationFunctionDescription</source>
+        <translation>Return the registration state of each proxy config, in JSON.</translation>
+    </message>
+    <message>
+        <source>getStatisticsFunctionDescription</source>
+        <translation>Return the models sizes and the caches counters (hits, misses, sizes), in JSON.</translation>
+    </message>
+    <message>
+        <source>getUnreadMessagesFunctionDescription</source>
+        <translation>Return the unread messages count, total and by chat room, in JSON.</translation>
+    </message>
     <message>
         <source>initiateConferenceFunctionDescription</source>
         <translation>Initiate a conference.</translation>
@@ -453,6 +485,14 @@ Server url not configured.</translation>
         <source>joinConferenceAsFunctionDescription</source>
         <translation>Join the conference hosted by the sip-address as with the guest-sip-address. If you are not connected to a proxy-config, see join-conference.</translation>
     </message>
+    <message>
+        <source>quitFunctionDescription</source>
+        <translation>Quit the application.</translation>
+    </message>
+    <message>
+        <source>setLogLevelFunctionDescription</source>
+        <translation>Set at runtime the minimum log level (debug, trace, message, warning, error or fatal) of a domain: a core domain like belle-sip, mediastreamer or ortp, * for all core domains, qt for the application or a Qt logging category.</translation>
+    </message>
 </context>
 <context>
     <name>CodecsViewer</name>
@@ -1002,6 +1042,10 @@ your friend&apos;s SIP address or username.</translation>
         <source>newFileMessage</source>
         <translation>New attachment received!</translation>
     </message>
+    <message>
+        <source>newMessages</source>
+        <translation>%1 new messages</translation>
+    </message>
 </context>
 <context>
     <name>OutgoingMessage</name>
@@ -1063,6 +1107,10 @@ your friend&apos;s SIP address or username.</translation>
         <source>logsEnabledLabel</source>
         <translation>Logs enabled</translation>
     </message>
+    <message>
+        <source>logsLevelsLabel</source>
+        <translation>Logs levels</translation>
+    </message>
     <message>
         <source>cleanLogs</source>
         <translation>CLEAN LOGS</translation>
@@ -72,6 +72,14 @@
         <source>commandLineOptionCliHelp</source>
         <translation>affiche le menu d&apos;aide pour l&apos;utilisation de Linphone en CLI</translation>
     </message>
+    <message>
+        <source>commandLineOptionCliBatch</source>
+        <translation>lire les commandes sur l&apos;entrée standard, une par ligne, et les envoyer à l&apos;application en cours d&apos;exécution via une seule connexion. Chaque commande est acquittée sur la sortie standard</translation>
+    </message>
+    <message>
+        <source>commandLineOptionHeadless</source>
+        <translation>lancer sans fenêtres (uniquement le cœur, piloté par la CLI)</translation>
+    </message>
     <message>
         <source>commandLineDescription</source>
         <translation>envoie un ordre à l&apos;application Linphone, voir --cli-help pour plus de détails</translation>
@@ -429,6 +437,14 @@ Url du serveur non configurée.</translation>
         <source>cliCommandLineSyntax</source>
         <translation>linphone &quot;&lt;method&gt; ([&lt;argument&gt;=&lt;valeur&gt;]*)&quot;</translation>
     </message>
+    <message>
+        <source>cliBatchCommandLineSyntax</source>
+        <translation>linphone --cli-batch &lt; &lt;fichier&gt;</translation>
+    </message>
+    <message>
+        <source>cliBatchDescription</source>
+        <translation>En mode batch, chaque ligne est une commande (les lignes vides et celles commençant par # sont ignorées). Chaque commande est acquittée par une ligne : OK &lt;ligne&gt; [&lt;résultat&gt;] ou ERROR &lt;ligne&gt; &lt;message&gt;.</translation>
+    </message>
     <message>
         <source>commandsName</source>
         <translation>liste des commandes :</translation>
@@ -441,6 +457,22 @@ Url du serveur non configurée.</translation>
         <source>callFunctionDescription</source>
         <translation>Initie un appel vers la sip-address.</translation>
     </message>
+    <message>
+        <source>getCallsFunctionDescription</source>
+        <translation>Retourne les appels actifs avec leur état et leurs dernières statistiques, en JSON.</translation>
+    </message>
+    <message>
+        <source>getRegistrationFunctionDescription</source>
+        <translation>Retourne l&apos;état d&apos;enregistrement de chaque proxy config, en JSON.</translation>
+    </message>
+    <message>
+        <source>getStatisticsFunctionDescription</source>
+        <translation>Retourne la taille des modèles et les compteurs des caches (succès, échecs, tailles), en JSON.</translation>
+    </message>
+    <message>
+        <source>getUnreadMessagesFunctionDescription</source>
+        <translation>Retourne le nombre de messages non lus, total et par conversation, en JSON.</translation>
+    </message>
     <message>
         <source>initiateConferenceFunctionDescription</source>
         <translation>Initie une conférence.</translation>
@@ -453,6 +485,14 @@ Url du serveur non configurée.</translation>
         <source>joinConferenceAsFunctionDescription</source>
         <translation>Rejoint la conférence hébergée par la sip-address avec la guest-sip-address. Si vous n&apos;êtes pas connecté à une proxy-config, voir join-conference.</translation>
     </message>
+    <message>
+        <source>quitFunctionDescription</source>
+        <translation>Quitte l&apos;application.</translation>
+    </message>
+    <message>
+        <source>setLogLevelFunctionDescription</source>
+        <translation>Change à chaud le niveau minimum de logs (debug, trace, message, warning, error ou fatal) d&apos;un domaine : un domaine du core comme belle-sip, mediastreamer ou ortp, * pour tous les domaines du core, qt pour l&apos;application ou une catégorie de logs Qt.</translation>
+    </message>
 </context>
 <context>
     <name>CodecsViewer</name>
@@ -1000,6 +1040,10 @@ Cliquez ici : &lt;a href=&quot;%1&quot;&gt;%1&lt;/a&gt;
         <source>newFileMessage</source>
         <translation>Pièce jointe reçue !</translation>
     </message>
+    <message>
+        <source>newMessages</source>
+        <translation>%1 nouveaux messages</translation>
+    </message>
 </context>
 <context>
     <name>OutgoingMessage</name>
@@ -1061,6 +1105,10 @@ Cliquez ici : &lt;a href=&quot;%1&quot;&gt;%1&lt;/a&gt;
         <source>logsEnabledLabel</source>
         <translation>Logs activés.</translation>
     </message>
+    <message>
+        <source>logsLevelsLabel</source>
+        <translation>Niveaux de logs</translation>
+    </message>
     <message>
         <source>cleanLogs</source>
         <translation>SUPPRIMER LOGS</translation>
@@ -20,8 +20,11 @@
  *      Author: Ronan Abhamon
  */
 
+#include <cstring>
+
 #include <QCommandLineParser>
 #include <QDir>
+#include <QFileInfo>
 #include <QFileSelector>
 #include <QMenu>
 #include <QQmlFileSelector>
@@ -73,9 +76,32 @@ static inline shared_ptr<linphone::Config> getConfigIfExists (const QCommandLine
   return nullptr;
 }
 
+// Instances of different profiles (config file or profile directory) run side
+// by side, e.g. several headless instances on one host.
+// Note: Computed before the options parser, which needs the app.
+static QByteArray getInstanceKey (int argc, char *argv[]) {
+  QByteArray key(Paths::getProfileDirPath().c_str());
+
+  static const char configOption[] = "--config";
+  for (int i = 1; i < argc; ++i) {
+    const char *configPath = nullptr;
+    if (!strcmp(argv[i], configOption) && i + 1 < argc)
+      configPath = argv[++i];
+    else if (!strncmp(argv[i], configOption, sizeof configOption - 1) && argv[i][sizeof configOption - 1] == '=')
+      configPath = argv[i] + sizeof configOption;
+
+    if (configPath)
+      key += '\n' + QFileInfo(QString::fromLocal8Bit(configPath)).absoluteFilePath().toUtf8();
+  }
+
+  return key;
+}
+
 // -----------------------------------------------------------------------------
 
-App::App (int &argc, char *argv[]) : SingleApplication(argc, argv, true, Mode::User | Mode::ExcludeAppPath | Mode::ExcludeAppVersion) {
+App::App (int &argc, char *argv[]) : SingleApplication(
+  argc, argv, true, Mode::User | Mode::ExcludeAppPath | Mode::ExcludeAppVersion, 100, ::getInstanceKey(argc, argv)
+) {
   setWindowIcon(QIcon(WINDOW_ICON_PATH));
 
   createParser();
@@ -105,6 +131,16 @@ App::App (int &argc, char *argv[]) : SingleApplication(argc, argv, true, Mode::U
     ::exit(EXIT_SUCCESS);
   }
 
+  mHeadless = mParser->isSet("headless");
+
+  if (mParser->isSet("cli-batch")) {
+    if (isPrimary()) {
+      qWarning() << QStringLiteral("No running application to send the batch commands.");
+      ::exit(EXIT_FAILURE);
+    }
+    ::exit(Cli::executeBatch());
+  }
+
   if (mParser->isSet("version"))
     mParser->showVersion();
 
@@ -172,6 +208,9 @@ void App::initContentApp () {
         qInfo() << QStringLiteral("Received command from other application: `%1`.").arg(command);
         Cli::executeCommand(command);
       });
+    QObject::connect(this, &App::receivedRequest, this, [this](quint64 requestId, const QByteArray &request) {
+        sendReply(requestId, Cli::executeRequest(request));
+      });
 
     // Add plugins directory.
     addLibraryPath(::Utils::coreStringToAppString(Paths::getPluginsDirPath()));
@@ -194,6 +233,12 @@ void App::initContentApp () {
     }
   }
 
+  // Only the core and the models, driven by the CLI.
+  if (mHeadless) {
+    qInfo() << QStringLiteral("Running headless, without QML engine.");
+    return;
+  }
+
   // Init engine content.
   mEngine = new QQmlApplicationEngine();
 
@@ -272,20 +317,23 @@ QString App::getCommandArgument () {
 // -----------------------------------------------------------------------------
 
 QQuickWindow *App::getCallsWindow () {
-  if (!mCallsWindow)
+  if (!mCallsWindow && mEngine)
     mCallsWindow = ::createSubWindow(mEngine, QML_VIEW_CALLS_WINDOW);
 
   return mCallsWindow;
 }
 
 QQuickWindow *App::getMainWindow () const {
+  if (!mEngine)
+    return nullptr;
+
   return qobject_cast<QQuickWindow *>(
     const_cast<QQmlApplicationEngine *>(mEngine)->rootObjects().at(0)
   );
 }
 
 QQuickWindow *App::getSettingsWindow () {
-  if (!mSettingsWindow) {
+  if (!mSettingsWindow && mEngine) {
     mSettingsWindow = ::createSubWindow(mEngine, QML_VIEW_SETTINGS_WINDOW);
     QObject::connect(mSettingsWindow, &QWindow::visibilityChanged, this, [](QWindow::Visibility visibility) {
         if (visibility == QWindow::Hidden) {
@@ -302,6 +350,10 @@ QQuickWindow *App::getSettingsWindow () {
 // -----------------------------------------------------------------------------
 
 void App::smartShowWindow (QQuickWindow *window) {
+  // No window in headless mode.
+  if (!window)
+    return;
+
   window->setVisible(true);
 
   if (window->visibility() == QWindow::Minimized)
@@ -314,7 +366,8 @@ void App::smartShowWindow (QQuickWindow *window) {
 // -----------------------------------------------------------------------------
 
 bool App::hasFocus () const {
-  return getMainWindow()->isActive() || (mCallsWindow && mCallsWindow->isActive());
+  const QQuickWindow *mainWindow = getMainWindow();
+  return (mainWindow && mainWindow->isActive()) || (mCallsWindow && mCallsWindow->isActive());
 }
 
 // -----------------------------------------------------------------------------
@@ -328,6 +381,8 @@ void App::createParser () {
   mParser->addOptions({
     { { "h", "help" }, tr("commandLineOptionHelp") },
     { "cli-help", tr("commandLineOptionCliHelp") },
+    { "cli-batch", tr("commandLineOptionCliBatch") },
+    { "headless", tr("commandLineOptionHeadless") },
     { { "v", "version" }, tr("commandLineOptionVersion") },
     { "config", tr("commandLineOptionConfig"), tr("commandLineOptionConfigArg") },
     #ifndef Q_OS_MACOS
@@ -63,6 +63,7 @@ public:
     return mEngine;
   }
 
+  // Null in headless mode.
   Notifier *getNotifier () const {
     return mNotifier;
   }
@@ -75,8 +76,14 @@ public:
     return mSystemTrayIcon;
   }
 
+  // Null in headless mode.
   QQuickWindow *getMainWindow () const;
 
+  // Without QML engine, windows and notifications.
+  bool isHeadless () const {
+    return mHeadless;
+  }
+
   bool hasFocus () const;
 
   static App *getInstance () {
@@ -129,6 +136,7 @@ private:
   QString mLocale;
 
   QCommandLineParser *mParser = nullptr;
+  bool mHeadless = false;
 
   QQmlApplicationEngine *mEngine = nullptr;
 
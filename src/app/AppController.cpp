@@ -20,6 +20,8 @@
  *      Author: Ronan Abhamon
  */
 
+#include <cstring>
+
 #include <QDirIterator>
 #include <QFontDatabase>
 #include <QMessageBox>
@@ -46,6 +48,15 @@ AppController::AppController (int &argc, char *argv[]) {
   // Disable QML cache. Avoid malformed cache.
   qputenv("QML_DISABLE_DISK_CACHE", "true");
 
+  // Headless mode: no display needed.
+  // Note: The options parser is created with the app, too late for the platform.
+  if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    for (int i = 1; i < argc; ++i)
+      if (!strcmp(argv[i], "--headless")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+        break;
+      }
+
   // ---------------------------------------------------------------------------
   // OpenGL properties.
   // ---------------------------------------------------------------------------
@@ -90,12 +101,25 @@ AppController::AppController (int &argc, char *argv[]) {
       mApp->processEvents();
     #endif // ifdef Q_OS_MACOS
 
+    // A headless launch never raises the window of the running instance.
     QString command = mApp->getCommandArgument();
-    mApp->sendMessage(command.isEmpty() ? "show" : command.toLocal8Bit(), -1);
+    if (command.isEmpty() && mApp->isHeadless()) {
+      qWarning() << QStringLiteral("An application is already running with this profile.");
+      return;
+    }
+
+    // Bounded by the default timeout: the command is dropped if the primary
+    // instance does not respond, instead of blocking this process.
+    if (!mApp->sendMessage(command.isEmpty() ? "show" : command.toLocal8Bit(), -1))
+      qWarning() << QStringLiteral("Unable to send command to the running application: `%1`.").arg(command);
 
     return;
   }
 
+  // Nothing to render.
+  if (mApp->isHeadless())
+    return;
+
   // ---------------------------------------------------------------------------
   // Fonts.
   // ---------------------------------------------------------------------------
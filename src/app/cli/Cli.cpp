@@ -22,28 +22,53 @@
 
 #include <iostream>
 
+#include <QJsonDocument>
+#include <QTimer>
+
+#include "../../components/call/CallModel.hpp"
 #include "../../components/core/CoreManager.hpp"
 #include "../../utils/Utils.hpp"
 #include "../App.hpp"
+#include "../logger/Logger.hpp"
+#include "../providers/ImageProvider.hpp"
+#include "../providers/ThumbnailProvider.hpp"
+#include "../providers/ThumbnailStore.hpp"
 
 #include "Cli.hpp"
 
+// Timeout to connect to the running application in batch mode.
+#define BATCH_CONNECTION_TIMEOUT 5000
+#define BATCH_REQUEST_TIMEOUT 30000
+
 using namespace std;
 
 // =============================================================================
 // API.
 // =============================================================================
 
-static void cliShow (QHash<QString, QString> &) {
+static bool cliShow (QHash<QString, QString> &, QString &output) {
   App *app = App::getInstance();
+  if (app->isHeadless()) {
+    output = QStringLiteral("No window in headless mode.");
+    return false;
+  }
+
   app->smartShowWindow(app->getMainWindow());
+  return true;
+}
+
+static bool cliQuit (QHash<QString, QString> &, QString &) {
+  // Queued: the reply must be sent before.
+  QTimer::singleShot(0, App::getInstance(), &App::quit);
+  return true;
 }
 
-static void cliCall (QHash<QString, QString> &args) {
+static bool cliCall (QHash<QString, QString> &args, QString &) {
   CoreManager::getInstance()->getCallsListModel()->launchAudioCall(args["sip-address"]);
+  return true;
 }
 
-static void cliJoinConference (QHash<QString, QString> &args) {
+static bool cliJoinConference (QHash<QString, QString> &args, QString &) {
   const QString sipAddress = args.take("sip-address");
 
   CoreManager *coreManager = CoreManager::getInstance();
@@ -57,17 +82,18 @@ static void cliJoinConference (QHash<QString, QString> &args) {
 
   args["method"] = QStringLiteral("join-conference");
   coreManager->getCallsListModel()->launchAudioCall(sipAddress, args);
+  return true;
 }
 
-static void cliJoinConferenceAs (QHash<QString, QString> &args) {
+static bool cliJoinConferenceAs (QHash<QString, QString> &args, QString &output) {
   const QString fromSipAddress = args.take("guest-sip-address");
   const QString toSipAddress = args.take("sip-address");
   CoreManager *coreManager = CoreManager::getInstance();
   shared_ptr<linphone::ProxyConfig> proxyConfig = coreManager->getCore()->getDefaultProxyConfig();
 
   if (!proxyConfig) {
-    qWarning() << QStringLiteral("You have no proxy config.");
-    return;
+    output = QStringLiteral("You have no proxy config.");
+    return false;
   }
 
   const shared_ptr<const linphone::Address> currentSipAddress = proxyConfig->getIdentityAddress();
@@ -75,24 +101,25 @@ static void cliJoinConferenceAs (QHash<QString, QString> &args) {
       ::Utils::appStringToCoreString(fromSipAddress)
     );
   if (!currentSipAddress->weakEqual(askedSipAddress)) {
-    qWarning() << QStringLiteral("Guest sip address `%1` doesn't match with default proxy config.")
+    output = QStringLiteral("Guest sip address `%1` doesn't match with default proxy config.")
       .arg(fromSipAddress);
-    return;
+    return false;
   }
 
   args["method"] = QStringLiteral("join-conference");
   coreManager->getCallsListModel()->launchAudioCall(toSipAddress, args);
+  return true;
 }
 
-static void cliInitiateConference (QHash<QString, QString> &args) {
+static bool cliInitiateConference (QHash<QString, QString> &args, QString &output) {
   shared_ptr<linphone::Core> core = CoreManager::getInstance()->getCore();
 
   // Check identity.
   {
     shared_ptr<linphone::Address> address = core->interpretUrl(::Utils::appStringToCoreString(args["sip-address"]));
     if (!address || address->getUsername().empty()) {
-      qWarning() << QStringLiteral("Unable to parse invalid sip address.");
-      return;
+      output = QStringLiteral("Unable to parse invalid sip address.");
+      return false;
     }
 
     address->clean();
@@ -100,15 +127,15 @@ static void cliInitiateConference (QHash<QString, QString> &args) {
     const string sipAddress = address->asString();
     shared_ptr<linphone::ProxyConfig> proxyConfig = core->getDefaultProxyConfig();
     if (!proxyConfig) {
-      qWarning() << QStringLiteral("Not connected to a proxy config");
-      return;
+      output = QStringLiteral("Not connected to a proxy config");
+      return false;
     }
     const string identity = proxyConfig->getIdentityAddress()->asStringUriOnly();
     if (sipAddress != identity) {
-      qWarning() << QStringLiteral("Received different sip address from identity : `%1 != %2`.")
+      output = QStringLiteral("Received different sip address from identity : `%1 != %2`.")
         .arg(::Utils::coreStringToAppString(identity))
         .arg(::Utils::coreStringToAppString(sipAddress));
-      return;
+      return false;
     }
   }
 
@@ -122,7 +149,7 @@ static void cliInitiateConference (QHash<QString, QString> &args) {
       qInfo() << QStringLiteral("Conference `%1` already exists.").arg(id);
       // TODO: Set the view to the "waiting call view".
       app->smartShowWindow(app->getCallsWindow());
-      return;
+      return true;
     }
 
     qInfo() << QStringLiteral("Remove existing conference with id: `%1`.")
@@ -135,11 +162,90 @@ static void cliInitiateConference (QHash<QString, QString> &args) {
   conference->setId(::Utils::appStringToCoreString(id));
 
   if (core->enterConference() == -1) {
-    qWarning() << QStringLiteral("Unable to join created conference: `%1`.").arg(id);
-    return;
+    output = QStringLiteral("Unable to join created conference: `%1`.").arg(id);
+    return false;
   }
   // TODO: Set the view to the "waiting call view".
   app->smartShowWindow(app->getCallsWindow());
+  return true;
+}
+
+static bool cliSetLogLevel (QHash<QString, QString> &args, QString &output) {
+  // Runtime only. Use the `logs_levels` setting to keep it after restart.
+  if (Logger::getInstance()->setLogLevel(args["domain"], args["level"]))
+    return true;
+
+  output = QStringLiteral("Invalid log level: `%1=%2`.").arg(args["domain"]).arg(args["level"]);
+  return false;
+}
+
+// =============================================================================
+// Queries. The output is a compact json document.
+// =============================================================================
+
+static inline QString toJson (const QVariant &variant) {
+  return QString::fromUtf8(QJsonDocument::fromVariant(variant).toJson(QJsonDocument::Compact));
+}
+
+static bool cliGetCalls (QHash<QString, QString> &, QString &output) {
+  CallsListModel *callsListModel = CoreManager::getInstance()->getCallsListModel();
+
+  QVariantList calls;
+  for (int row = 0, count = callsListModel->rowCount(); row < count; ++row) {
+    const CallModel *callModel = callsListModel->data(callsListModel->index(row, 0)).value<CallModel *>();
+    if (callModel)
+      calls << callModel->getDescription();
+  }
+
+  output = ::toJson(calls);
+  return true;
+}
+
+static bool cliGetRegistration (QHash<QString, QString> &, QString &output) {
+  output = ::toJson(CoreManager::getInstance()->getAccountSettingsModel()->getRegistrationDescription());
+  return true;
+}
+
+static bool cliGetUnreadMessages (QHash<QString, QString> &, QString &output) {
+  int total = 0;
+  QVariantMap chatRooms;
+  for (const auto &chatRoom : CoreManager::getInstance()->getCore()->getChatRooms()) {
+    const int count = chatRoom->getUnreadMessagesCount();
+    if (!count)
+      continue;
+
+    total += count;
+    chatRooms[::Utils::coreStringToAppString(chatRoom->getPeerAddress()->asStringUriOnly())] = count;
+  }
+
+  QVariantMap unreadMessages;
+  unreadMessages["count"] = total;
+  unreadMessages["chatRooms"] = chatRooms;
+
+  output = ::toJson(unreadMessages);
+  return true;
+}
+
+static bool cliGetStatistics (QHash<QString, QString> &, QString &output) {
+  CoreManager *coreManager = CoreManager::getInstance();
+
+  QVariantMap models;
+  models["calls"] = coreManager->getCallsListModel()->rowCount();
+  models["contacts"] = coreManager->getContactsListModel()->rowCount();
+  models["sipAddresses"] = coreManager->getSipAddressesModel()->rowCount();
+  models["chatRooms"] = int(coreManager->getCore()->getChatRooms().size());
+
+  QVariantMap caches;
+  caches["images"] = ImageProvider::getCacheStatistics();
+  caches["thumbnails"] = ThumbnailProvider::getCacheStatistics();
+  caches["thumbnailsStore"] = ThumbnailStore::getInstance()->getStatistics();
+
+  QVariantMap statistics;
+  statistics["models"] = models;
+  statistics["caches"] = caches;
+
+  output = ::toJson(statistics);
+  return true;
 }
 
 // =============================================================================
@@ -236,23 +342,22 @@ Cli::Command::Command (
   mFunction(function),
   mArgsScheme(argsScheme) {}
 
-void Cli::Command::execute (QHash<QString, QString> &args) const {
+bool Cli::Command::execute (QHash<QString, QString> &args, QString &output) const {
   // Check arguments validity.
   for (const auto &argName : args.keys()) {
     if (!mArgsScheme.contains(argName)) {
-      qWarning() << QStringLiteral("Command with invalid argument: `%1 (%2)`.")
+      output = QStringLiteral("Command with invalid argument: `%1 (%2)`.")
         .arg(mFunctionName).arg(argName);
-
-      return;
+      return false;
     }
   }
 
   // Check missing arguments.
   for (const auto &argName : mArgsScheme.keys()) {
     if (!mArgsScheme[argName].isOptional && (!args.contains(argName) || args[argName].isEmpty())) {
-      qWarning() << QStringLiteral("Missing argument for command: `%1 (%2)`.")
+      output = QStringLiteral("Missing argument for command: `%1 (%2)`.")
         .arg(mFunctionName).arg(argName);
-      return;
+      return false;
     }
   }
 
@@ -260,17 +365,22 @@ void Cli::Command::execute (QHash<QString, QString> &args) const {
   CoreManager *coreManager = CoreManager::getInstance();
 
   if (coreManager->started())
-    (*mFunction)(args);
-  else {
-    Function f = mFunction;
-    ::Utils::connectOnce(coreManager->getHandlers().get(), &CoreHandlers::coreStarted, coreManager, [f, args] {
-      QHash<QString, QString> fuckConst = args;
-      (*f)(fuckConst);
-    });
-  }
+    return (*mFunction)(args, output);
+
+  // Acknowledged now, the result is only logged.
+  Function f = mFunction;
+  QString functionName = mFunctionName;
+  ::Utils::connectOnce(coreManager->getHandlers().get(), &CoreHandlers::coreStarted, coreManager, [f, functionName, args] {
+    QHash<QString, QString> fuckConst = args;
+    QString output;
+    if (!(*f)(fuckConst, output))
+      qWarning() << QStringLiteral("Deferred command `%1` failed: %2").arg(functionName).arg(output);
+  });
+  output = QStringLiteral("deferred");
+  return true;
 }
 
-void Cli::Command::executeUri (const shared_ptr<linphone::Address> &address) const {
+bool Cli::Command::executeUri (const shared_ptr<linphone::Address> &address, QString &output) const {
   QHash<QString, QString> args;
   // TODO: check if there is too much headers.
   for (const auto &argName : mArgsScheme.keys()) {
@@ -279,7 +389,7 @@ void Cli::Command::executeUri (const shared_ptr<linphone::Address> &address) con
   }
   address->clean();
   args["sip-address"] = ::Utils::coreStringToAppString(address->asStringUriOnly());
-  execute(args);
+  return execute(args, output);
 }
 
 QString Cli::Command::getFunctionSyntax () const {
@@ -308,16 +418,15 @@ QString Cli::Command::getFunctionSyntax () const {
 
 // =============================================================================
 
-// FIXME: Do not accept args without value like: cmd toto.
-// In the future `toto` could be a boolean argument.
-QRegExp Cli::mRegExpArgs("(?:(?:([\\w-]+)\\s*)=\\s*(?:\"([^\"\\\\]*(?:\\\\.[^\"\\\\]*)*)\"|([^\\s]+)\\s*))");
-QRegExp Cli::mRegExpFunctionName("^\\s*([a-z-]+)\\s*");
-
 QMap<QString, Cli::Command> Cli::mCommands = {
   createCommand("show", QT_TR_NOOP("showFunctionDescription"), ::cliShow),
   createCommand("call", QT_TR_NOOP("callFunctionDescription"), ::cliCall, {
     { "sip-address", {} }
   }),
+  createCommand("get-calls", QT_TR_NOOP("getCallsFunctionDescription"), ::cliGetCalls),
+  createCommand("get-registration", QT_TR_NOOP("getRegistrationFunctionDescription"), ::cliGetRegistration),
+  createCommand("get-statistics", QT_TR_NOOP("getStatisticsFunctionDescription"), ::cliGetStatistics),
+  createCommand("get-unread-messages", QT_TR_NOOP("getUnreadMessagesFunctionDescription"), ::cliGetUnreadMessages),
   createCommand("initiate-conference", QT_TR_NOOP("initiateConferenceFunctionDescription"), ::cliInitiateConference, {
     { "sip-address", {} }, { "conference-id", {} }
   }),
@@ -326,28 +435,37 @@ QMap<QString, Cli::Command> Cli::mCommands = {
   }),
   createCommand("join-conference-as", QT_TR_NOOP("joinConferenceAsFunctionDescription"), ::cliJoinConferenceAs, {
     { "sip-address", {} }, { "conference-id", {} }, { "guest-sip-address", {} }
+  }),
+  createCommand("quit", QT_TR_NOOP("quitFunctionDescription"), ::cliQuit),
+  createCommand("set-log-level", QT_TR_NOOP("setLogLevelFunctionDescription"), ::cliSetLogLevel, {
+    { "domain", {} }, { "level", {} }
   })
 };
 
 // -----------------------------------------------------------------------------
 
-void Cli::executeCommand (const QString &command, CommandFormat *format) {
+bool Cli::execute (const QString &command, CommandFormat *format, QString &output) {
   shared_ptr<linphone::Address> address = linphone::Factory::get()->createAddress(
       ::Utils::appStringToCoreString(command)
     );
 
   // Execute cli command.
   if (!address) {
-    const QString &functionName = parseFunctionName(command);
-    if (!functionName.isEmpty()) {
-      QHash<QString, QString> args = parseArgs(command);
-      mCommands[functionName].execute(args);
-    }
-
     if (format)
       *format = CliFormat;
 
-    return;
+    QString functionName;
+    QHash<QString, QString> args;
+    if (!parseCommand(command, functionName, args, output))
+      return false;
+
+    auto it = mCommands.constFind(functionName);
+    if (it == mCommands.cend()) {
+      output = QStringLiteral("This command doesn't exist: `%1`.").arg(functionName);
+      return false;
+    }
+
+    return it->execute(args, output);
   }
 
   if (format)
@@ -358,20 +476,32 @@ void Cli::executeCommand (const QString &command, CommandFormat *format) {
 
   string scheme = address->getScheme();
   if (scheme != "sip" && scheme != "sip-linphone") {
-    qWarning() << QStringLiteral("Not a valid uri: `%1`.").arg(command);
-    return;
+    output = QStringLiteral("Not a valid uri: `%1`.").arg(command);
+    return false;
   }
 
   const QString functionName = ::Utils::coreStringToAppString(address->getHeader("method")).isEmpty()
     ? QStringLiteral("call")
     : ::Utils::coreStringToAppString(address->getHeader("method"));
 
-  if (!functionName.isEmpty() && !mCommands.contains(functionName)) {
-    qWarning() << QStringLiteral("This command doesn't exist: `%1`.").arg(functionName);
-    return;
+  auto it = mCommands.constFind(functionName);
+  if (it == mCommands.cend()) {
+    output = QStringLiteral("This command doesn't exist: `%1`.").arg(functionName);
+    return false;
   }
 
-  mCommands[functionName].executeUri(address);
+  return it->executeUri(address, output);
+}
+
+bool Cli::executeCommand (const QString &command, CommandFormat *format, QString *output) {
+  QString result;
+  const bool success = execute(command, format, result);
+  if (!success)
+    qWarning() << result;
+
+  if (output)
+    *output = result;
+  return success;
 }
 
 void Cli::showHelp () {
@@ -381,6 +511,9 @@ void Cli::showHelp () {
     endl <<
     multilineIndent(tr("uriCommandLineSyntax"), 0) <<
     multilineIndent(tr("cliCommandLineSyntax"), 0) <<
+    multilineIndent(tr("cliBatchCommandLineSyntax"), 0) <<
+    endl <<
+    multilineIndent(tr("cliBatchDescription"), 0) <<
     endl <<
     multilineIndent(tr("commandsName")) << endl;
 
@@ -390,6 +523,60 @@ void Cli::showHelp () {
       endl;
 }
 
+QByteArray Cli::executeRequest (const QByteArray &request) {
+  const QString command = QString::fromUtf8(request);
+  qInfo() << QStringLiteral("Received batch command: `%1`.").arg(command);
+
+  QString output;
+  const bool success = executeCommand(command, nullptr, &output);
+
+  // One line by reply.
+  output.replace('\n', ' ');
+
+  QByteArray reply = success ? "OK" : "ERROR";
+  if (!output.isEmpty())
+    reply += ' ' + output.toUtf8();
+  return reply;
+}
+
+int Cli::executeBatch () {
+  App *app = App::getInstance();
+  if (!app->openChannel(BATCH_CONNECTION_TIMEOUT)) {
+    qWarning() << QStringLiteral("Unable to open a channel to the running application.");
+    return EXIT_FAILURE;
+  }
+
+  int exitCode = EXIT_SUCCESS;
+  string line;
+  for (int lineNumber = 1; getline(cin, line); ++lineNumber) {
+    const QByteArray command = QByteArray::fromStdString(line).trimmed();
+    if (command.isEmpty() || command.startsWith('#'))
+      continue;
+
+    // No reply in time: the next replies could not be matched to their
+    // commands anymore, the batch is stopped.
+    QByteArray reply;
+    if (!app->sendRequest(command, reply, BATCH_REQUEST_TIMEOUT)) {
+      qWarning() << QStringLiteral("No reply from the running application.");
+      cout << "ERROR " << lineNumber << " No reply from the running application." << endl;
+      return EXIT_FAILURE;
+    }
+
+    // Written as `<status> <line number> [<output>]`.
+    const int separator = reply.indexOf(' ');
+    const QByteArray status = separator == -1 ? reply : reply.left(separator);
+    cout << status.constData() << " " << lineNumber;
+    if (separator != -1)
+      cout << reply.constData() + separator;
+    cout << endl;
+
+    if (status != "OK")
+      exitCode = EXIT_FAILURE;
+  }
+
+  return exitCode;
+}
+
 // -----------------------------------------------------------------------------
 
 pair<QString, Cli::Command> Cli::createCommand (
@@ -403,32 +590,73 @@ pair<QString, Cli::Command> Cli::createCommand (
 
 // -----------------------------------------------------------------------------
 
-QString Cli::parseFunctionName (const QString &command) {
-  mRegExpFunctionName.indexIn(command);
-  if (mRegExpFunctionName.pos(1) == -1) {
-    qWarning() << QStringLiteral("Unable to parse function name of command: `%1`.").arg(command);
-    return QString("");
-  }
-
-  const QStringList texts = mRegExpFunctionName.capturedTexts();
-
-  const QString functionName = texts[1];
-  if (!mCommands.contains(functionName)) {
-    qWarning() << QStringLiteral("This command doesn't exist: `%1`.").arg(functionName);
-    return QString("");
-  }
-
-  return functionName;
-}
-
-QHash<QString, QString> Cli::parseArgs (const QString &command) {
-  QHash<QString, QString> args;
+bool Cli::parseCommand (
+  const QString &command,
+  QString &functionName,
+  QHash<QString, QString> &args,
+  QString &error
+) {
+  const int length = command.length();
   int pos = 0;
 
-  while ((pos = mRegExpArgs.indexIn(command, pos)) != -1) {
-    pos += mRegExpArgs.matchedLength();
-    args[mRegExpArgs.cap(1)] = (mRegExpArgs.cap(2).isEmpty() ? mRegExpArgs.cap(3) : mRegExpArgs.cap(2));
+  auto skipSpaces = [&command, &pos, length] {
+    while (pos < length && command[pos].isSpace())
+      ++pos;
+  };
+
+  // Function name: `[a-z-]+`.
+  skipSpaces();
+  const int functionNameBegin = pos;
+  while (pos < length && (command[pos].isLower() || command[pos] == '-'))
+    ++pos;
+  if (pos == functionNameBegin || (pos < length && !command[pos].isSpace())) {
+    error = QStringLiteral("Unable to parse function name of command: `%1`.").arg(command);
+    return false;
   }
+  functionName = command.mid(functionNameBegin, pos - functionNameBegin);
+
+  // Arguments: `name=value` or `name="value"`. In a quoted value, `\` escapes the next character.
+  // FIXME: Do not accept args without value like: cmd toto.
+  // In the future `toto` could be a boolean argument.
+  for (;;) {
+    skipSpaces();
+    if (pos == length)
+      return true;
+
+    const int nameBegin = pos;
+    while (pos < length && (command[pos].isLetterOrNumber() || command[pos] == '-' || command[pos] == '_'))
+      ++pos;
+    const QString name = command.mid(nameBegin, pos - nameBegin);
+
+    skipSpaces();
+    if (name.isEmpty() || pos == length || command[pos] != '=') {
+      error = QStringLiteral("Unable to parse argument at position %1 of command: `%2`.").arg(nameBegin).arg(command);
+      return false;
+    }
+    ++pos;
+    skipSpaces();
+
+    QString value;
+    if (pos < length && command[pos] == '"') {
+      const int valueBegin = pos;
+      for (++pos; pos < length && command[pos] != '"'; ++pos) {
+        if (command[pos] == '\\' && pos + 1 < length)
+          ++pos;
+        value += command[pos];
+      }
+
+      if (pos == length) {
+        error = QStringLiteral("Unterminated value at position %1 of command: `%2`.").arg(valueBegin).arg(command);
+        return false;
+      }
+      ++pos;
+    } else {
+      const int valueBegin = pos;
+      while (pos < length && !command[pos].isSpace())
+        ++pos;
+      value = command.mid(valueBegin, pos - valueBegin);
+    }
 
-  return args;
+    args[name] = value;
+  }
 }
@@ -38,7 +38,9 @@ namespace linphone {
 class Cli : public QObject {
   Q_OBJECT;
 
-  typedef void (*Function)(QHash<QString, QString> &);
+  // Returns false on error, `output` is then the error message.
+  // Otherwise `output` is the optional result of the command.
+  typedef bool (*Function)(QHash<QString, QString> &args, QString &output);
 
   enum ArgumentType {
     STRING
@@ -64,8 +66,8 @@ class Cli : public QObject {
       const QHash<QString, Argument> &argsScheme
     );
 
-    void execute (QHash<QString, QString> &args) const;
-    void executeUri (const std::shared_ptr<linphone::Address> &address) const;
+    bool execute (QHash<QString, QString> &args, QString &output) const;
+    bool executeUri (const std::shared_ptr<linphone::Address> &address, QString &output) const;
 
     const char *getFunctionDescription () const {
       return mFunctionDescription;
@@ -89,7 +91,25 @@ public:
     UriFormat
   };
 
-  static void executeCommand (const QString &command, CommandFormat *format = nullptr);
+  // Returns false on error. See `Function` for the output.
+  static bool executeCommand (const QString &command, CommandFormat *format = nullptr, QString *output = nullptr);
+
+  // Executes a command received in batch mode, returns the reply:
+  // `OK [<output>]` or `ERROR <message>`.
+  static QByteArray executeRequest (const QByteArray &request);
+
+  // Batch mode, in a secondary instance: sends the commands read on stdin
+  // (one by line) to the running application on one channel.
+  // Each reply is written on stdout with the line number of its command.
+  static int executeBatch ();
+
+  // Single pass tokenizer: `<function-name> [<name>=<value> | <name>="<value>"]*`.
+  static bool parseCommand (
+    const QString &command,
+    QString &functionName,
+    QHash<QString, QString> &args,
+    QString &error
+  );
 
   static void showHelp ();
 
@@ -103,13 +123,9 @@ private:
     const QHash<QString, Argument> &argsScheme = QHash<QString, Argument>()
   );
 
-  static QString parseFunctionName (const QString &command);
-  static QHash<QString, QString> parseArgs (const QString &command);
+  static bool execute (const QString &command, CommandFormat *format, QString &output);
 
   static QMap<QString, Command> mCommands;
-
-  static QRegExp mRegExpArgs;
-  static QRegExp mRegExpFunctionName;
 };
 
 #endif // CLI_H_
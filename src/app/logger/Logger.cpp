@@ -20,10 +20,17 @@
  *      Author: Ronan Abhamon
  */
 
+#include <atomic>
+#include <cctype>
+
 #include <bctoolbox/logging.h>
 #include <linphone/linphonecore.h>
+#include <QCoreApplication>
 #include <QDateTime>
+#include <QLoggingCategory>
+#include <QTime>
 #include <QThread>
+#include <QTimer>
 
 #include "../../components/settings/SettingsModel.hpp"
 #include "../../utils/Utils.hpp"
@@ -47,11 +54,26 @@
 #endif // if defined(__linux__) || defined(__APPLE__)
 
 #define QT_DOMAIN "qt"
+#define QT_DEFAULT_CATEGORY "default"
+
+#define DEFAULT_LOG_LEVEL BCTBX_LOG_MESSAGE
 
 #define MAX_LOGS_COLLECTION_SIZE 10485760 /* 10MB. */
 
 #define SRC_PATTERN "/linphone-desktop/src/"
 
+#define DEFAULT_RATE_LIMIT_BURST 10
+#define DEFAULT_RATE_LIMIT_INTERVAL 1000 /* 1s. */
+#define MAX_RATE_LIMIT_STATES 4096
+#define RATE_LIMIT_FLUSH_INTERVAL 1000 /* 1s. */
+
+#define LOG_BUFFER_MIN_SIZE 512
+
+#define RATE_LIMIT_SUMMARY "%d similar messages suppressed (rate limited)."
+
+#define FNV_OFFSET_BASIS 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+
 using namespace std;
 
 // =============================================================================
@@ -62,36 +84,187 @@ Logger *Logger::mInstance = nullptr;
 
 // -----------------------------------------------------------------------------
 
-static inline QByteArray getFormattedCurrentTime () {
-  return QDateTime::currentDateTime().toString("HH:mm:ss:zzz").toLocal8Bit();
+namespace {
+  // Reusable formatting buffers. One instance per thread, so no lock is required.
+  struct LogBuffers {
+    LogBuffers () {
+      // Reserved capacity is kept when the line is cleared.
+      line.reserve(LOG_BUFFER_MIN_SIZE);
+    }
+
+    qint64 second = -1;
+    char time[sizeof "HH:mm:ss:zzz"];
+    char context[256];
+    QByteArray coreMessage; // Formatted before the core log handler.
+    QByteArray message;
+    QByteArray line;
+  };
+
+  struct LevelInfo {
+    const char *color;
+    const char *name;
+    const char *id; // Used in config.
+  };
+}
+
+static LogBuffers &getLogBuffers () {
+  static thread_local LogBuffers buffers;
+  return buffers;
+}
+
+static const LevelInfo *getLevelInfo (int level) {
+  static const LevelInfo debug = { GREEN, "Debug", "debug" };
+  static const LevelInfo trace = { BLUE, "Trace", "trace" };
+  static const LevelInfo message = { BLUE, "Info", "message" };
+  static const LevelInfo warning = { RED, "Warning", "warning" };
+  static const LevelInfo error = { RED, "Error", "error" };
+  static const LevelInfo fatal = { RED, "Fatal", "fatal" };
+
+  switch (level) {
+    case BCTBX_LOG_DEBUG:
+      return &debug;
+    case BCTBX_LOG_TRACE:
+      return &trace;
+    case BCTBX_LOG_MESSAGE:
+      return &message;
+    case BCTBX_LOG_WARNING:
+      return &warning;
+    case BCTBX_LOG_ERROR:
+      return &error;
+    case BCTBX_LOG_FATAL:
+      return &fatal;
+    default:
+      break;
+  }
+
+  return nullptr;
+}
+
+static int getLevelFromId (const QString &id) {
+  static const int levels[] = {
+    BCTBX_LOG_DEBUG, BCTBX_LOG_TRACE, BCTBX_LOG_MESSAGE, BCTBX_LOG_WARNING, BCTBX_LOG_ERROR, BCTBX_LOG_FATAL
+  };
+
+  const QString name = id.trimmed().toLower();
+  if (name == "info")
+    return BCTBX_LOG_MESSAGE;
+
+  for (int level : levels)
+    if (name == ::getLevelInfo(level)->id)
+      return level;
+
+  return -1;
+}
+
+static inline bool isQtCategory (const QString &domain) {
+  return domain == QT_DOMAIN || domain == QT_DEFAULT_CATEGORY || domain.contains('.');
+}
+
+// The conversion to local time is the expensive part, so the `HH:mm:ss:`
+// prefix is cached and only the milliseconds are written for each line.
+static const char *getFormattedCurrentTime (LogBuffers &buffers) {
+  const qint64 msecs = QDateTime::currentMSecsSinceEpoch();
+  const qint64 second = msecs / 1000;
+
+  if (second != buffers.second) {
+    const QTime time = QDateTime::fromMSecsSinceEpoch(second * 1000).time();
+    snprintf(buffers.time, sizeof buffers.time, "%02d:%02d:%02d:", time.hour(), time.minute(), time.second());
+    buffers.second = second;
+  }
+
+  const int ms = static_cast<int>(msecs - second * 1000);
+  buffers.time[9] = static_cast<char>('0' + ms / 100);
+  buffers.time[10] = static_cast<char>('0' + ms / 10 % 10);
+  buffers.time[11] = static_cast<char>('0' + ms % 10);
+  buffers.time[12] = '\0';
+
+  return buffers.time;
+}
+
+static const char *formatMessage (QByteArray &buffer, const char *fmt, va_list args) {
+  if (buffer.size() < LOG_BUFFER_MIN_SIZE)
+    buffer.resize(LOG_BUFFER_MIN_SIZE);
+
+  va_list argsCopy;
+  va_copy(argsCopy, args);
+
+  int size = vsnprintf(buffer.data(), static_cast<size_t>(buffer.size()), fmt, args);
+  if (size >= buffer.size()) {
+    buffer.resize(size + 1);
+    size = vsnprintf(buffer.data(), static_cast<size_t>(buffer.size()), fmt, argsCopy);
+  }
+
+  va_end(argsCopy);
+
+  return size < 0 ? "" : buffer.constData();
+}
+
+static void writeLine (int level, const char *domain, const void *thread, const char *context, const char *message) {
+  const QByteArray &line = Logger::formatLine(level, domain, thread, context, message);
+  fwrite(line.constData(), 1, static_cast<size_t>(line.size()), stderr);
+}
+
+// -----------------------------------------------------------------------------
+
+static inline quint64 hashBytes (quint64 hash, const char *bytes) {
+  for (; *bytes; ++bytes)
+    hash = (hash ^ static_cast<unsigned char>(*bytes)) * FNV_PRIME;
+  return hash;
+}
+
+static inline quint64 hashValue (quint64 hash, quint64 value) {
+  for (int i = 0; i < 8; ++i, value >>= 8)
+    hash = (hash ^ (value & 0xff)) * FNV_PRIME;
+  return hash;
+}
+
+// Hash only the constant part of a message. Quoted arguments (`...`) and
+// numbers are ignored, so "Add sip address: `a`." and "Add sip address: `b`."
+// share the same key when no call site is available.
+static quint64 hashMessageShape (const QString &msg) {
+  quint64 hash = FNV_OFFSET_BASIS;
+  bool quoted = false;
+
+  for (const QChar &c : msg) {
+    if (c == '`')
+      quoted = !quoted;
+    else if (!quoted && !c.isDigit())
+      hash = (hash ^ c.unicode()) * FNV_PRIME;
+  }
+
+  return hash;
+}
+
+// Same thing for the formatted core messages: numbers and `0x...` values
+// (pointers, ids) are ignored, so only a repeated text shares a key.
+static quint64 hashMessageShape (quint64 hash, const char *msg) {
+  for (; *msg; ++msg) {
+    if (msg[0] == '0' && (msg[1] == 'x' || msg[1] == 'X')) {
+      msg += 2;
+      while (isxdigit(static_cast<unsigned char>(*msg)))
+        ++msg;
+      if (!*msg)
+        break;
+    }
+
+    if (!isdigit(static_cast<unsigned char>(*msg)))
+      hash = (hash ^ static_cast<unsigned char>(*msg)) * FNV_PRIME;
+  }
+
+  return hash;
 }
 
 // -----------------------------------------------------------------------------
 
+// Core messages are rate limited before the core log handler, see `rateLimitedLog`.
 static void linphoneLog (const char *domain, OrtpLogLevel type, const char *fmt, va_list args) {
-  const char *format;
-
-  if (type == ORTP_DEBUG)
-    format = GREEN "[%s][Debug]" YELLOW "Core:%s: " RESET "%s\n";
-  else if (type == ORTP_TRACE)
-    format = BLUE "[%s][Trace]" YELLOW "Core:%s: " RESET "%s\n";
-  else if (type == ORTP_MESSAGE)
-    format = BLUE "[%s][Info]" YELLOW "Core:%s: " RESET "%s\n";
-  else if (type == ORTP_WARNING)
-    format = RED "[%s][Warning]" YELLOW "Core:%s: " RESET "%s\n";
-  else if (type == ORTP_ERROR)
-    format = RED "[%s][Error]" YELLOW "Core:%s: " RESET "%s\n";
-  else if (type == ORTP_FATAL)
-    format = RED "[%s][Fatal]" YELLOW "Core:%s: " RESET "%s\n";
-  else
+  if (!::getLevelInfo(type))
     return;
 
-  QByteArray dateTime = ::getFormattedCurrentTime();
-  char *msg = bctbx_strdup_vprintf(fmt, args);
-
-  fprintf(stderr, format, dateTime.constData(), domain ? domain : "linphone", msg);
+  if (!domain)
+    domain = "linphone";
 
-  bctbx_free(msg);
+  ::writeLine(type, domain, nullptr, nullptr, ::formatMessage(::getLogBuffers().message, fmt, args));
 
   if (type == ORTP_FATAL)
     abort();
@@ -99,52 +272,114 @@ static void linphoneLog (const char *domain, OrtpLogLevel type, const char *fmt,
 
 // -----------------------------------------------------------------------------
 
+// Handler installed by liblinphone: the logs collection when enabled, the
+// `linphoneLog` handler otherwise. Replaced on each collection state change.
+static atomic<BctbxLogFunc> coreLogHandler(nullptr);
+
+static void forwardCoreLog (const char *domain, BctbxLogLevel level, const char *fmt, ...) {
+  const BctbxLogFunc handler = coreLogHandler.load();
+  if (!handler)
+    return;
+
+  va_list args;
+  va_start(args, fmt);
+  handler(domain, level, fmt, args);
+  va_end(args);
+}
+
+// Placed before the core log handler, so floods are dropped from the logs
+// collection too and not only from the console.
+static void rateLimitedLog (const char *domain, BctbxLogLevel level, const char *fmt, va_list args) {
+  // Qt messages are forwarded to the core logger and already rate limited.
+  if (domain && !strcmp(domain, QT_DOMAIN)) {
+    const BctbxLogFunc handler = coreLogHandler.load();
+    if (handler)
+      handler(domain, level, fmt, args);
+    return;
+  }
+
+  // Core formats are often generic (`%s`...), so the formatted text is part of the key.
+  // The message is formatted once, then forwarded as is.
+  const char *message = ::formatMessage(::getLogBuffers().coreMessage, fmt, args);
+  const char *keyDomain = domain ? domain : "linphone";
+  const quint64 key = ::hashMessageShape(
+    ::hashBytes(::hashValue(FNV_OFFSET_BASIS, reinterpret_cast<quintptr>(fmt)), keyDomain), message
+  );
+
+  int suppressed;
+  if (!Logger::getInstance()->checkRateLimit(keyDomain, level, key, nullptr, suppressed))
+    return;
+
+  if (suppressed)
+    Logger::logRateLimitSummary(keyDomain, level, nullptr, suppressed);
+
+  ::forwardCoreLog(domain, level, "%s", message);
+}
+
+// liblinphone replaces the core log handler when the logs collection is
+// enabled or disabled, the rate limit must be put before it again.
+static void installRateLimitedLog () {
+  const BctbxLogFunc handler = bctbx_get_log_handler();
+  if (handler == ::rateLimitedLog)
+    return;
+
+  coreLogHandler = handler;
+  bctbx_set_log_handler(::rateLimitedLog);
+}
+
+// -----------------------------------------------------------------------------
+
 void Logger::log (QtMsgType type, const QMessageLogContext &context, const QString &msg) {
-  const char *format;
   BctbxLogLevel level;
 
-  if (type == QtDebugMsg) {
-    format = GREEN "[%s][%p][Debug]" PURPLE "%s" RESET "%s\n";
+  if (type == QtDebugMsg)
     level = BCTBX_LOG_DEBUG;
-  } else if (type == QtInfoMsg) {
-    format = BLUE "[%s][%p][Info]" PURPLE "%s" RESET "%s\n";
+  else if (type == QtInfoMsg)
     level = BCTBX_LOG_MESSAGE;
-  } else if (type == QtWarningMsg) {
-    format = RED "[%s][%p][Warning]" PURPLE "%s" RESET "%s\n";
+  else if (type == QtWarningMsg)
     level = BCTBX_LOG_WARNING;
-  } else if (type == QtCriticalMsg) {
-    format = RED "[%s][%p][Critical]" PURPLE "%s" RESET "%s\n";
+  else if (type == QtCriticalMsg)
     level = BCTBX_LOG_ERROR;
-  } else if (type == QtFatalMsg) {
-    format = RED "[%s][%p][Fatal]" PURPLE "%s" RESET "%s\n";
+  else if (type == QtFatalMsg)
     level = BCTBX_LOG_FATAL;
-  } else
+  else
     return;
 
+  LogBuffers &buffers = ::getLogBuffers();
   const char *contextStr = "";
 
   #ifdef QT_MESSAGELOGCONTEXT
-    QByteArray contextArr;
     {
       const char *file = context.file;
       const char *pos = file ? ::Utils::rstrstr(file, SRC_PATTERN) : file;
 
-      contextArr = QStringLiteral("%1:%2: ")
-        .arg(pos ? pos + sizeof(SRC_PATTERN) - 1 : file)
-        .arg(context.line)
-        .toLocal8Bit();
-      contextStr = contextArr.constData();
+      snprintf(
+        buffers.context, sizeof buffers.context, "%s:%d: ",
+        pos ? pos + sizeof(SRC_PATTERN) - 1 : (file ? file : ""), context.line
+      );
+      contextStr = buffers.context;
     }
-  #else
-    (void)context;
   #endif // ifdef QT_MESSAGELOGCONTEXT
 
-  QByteArray localMsg = msg.toLocal8Bit();
-  QByteArray dateTime = ::getFormattedCurrentTime();
+  // Drop the message as soon as possible if it comes from a flooding call site.
+  int suppressed;
+  {
+    const quint64 key = context.file
+      ? ::hashValue(::hashBytes(FNV_OFFSET_BASIS, context.file), static_cast<quint64>(context.line))
+      : ::hashMessageShape(msg);
+    if (!mInstance->checkRateLimit(QT_DOMAIN, level, key, contextStr, suppressed))
+      return;
+  }
+
+  if (suppressed)
+    logRateLimitSummary(QT_DOMAIN, level, contextStr, suppressed);
+
+  const QByteArray localMsg = msg.toLocal8Bit();
+  const QThread *thread = QThread::currentThread();
 
   mMutex.lock();
 
-  fprintf(stderr, format, dateTime.constData(), QThread::currentThread(), contextStr, localMsg.constData());
+  ::writeLine(level, nullptr, thread, contextStr, localMsg.constData());
   bctbx_log(QT_DOMAIN, level, "QT: %s%s", contextStr, localMsg.constData());
 
   mMutex.unlock();
@@ -153,10 +388,313 @@ void Logger::log (QtMsgType type, const QMessageLogContext &context, const QStri
     abort();
 }
 
+void Logger::logRateLimitSummary (const char *domain, int level, const char *context, int suppressed) {
+  char summary[64];
+  snprintf(summary, sizeof summary, RATE_LIMIT_SUMMARY, suppressed);
+
+  // Like the core messages, written in the logs collection and in verbose mode.
+  if (strcmp(domain, QT_DOMAIN)) {
+    ::forwardCoreLog(domain, static_cast<BctbxLogLevel>(level), "%s", summary);
+    return;
+  }
+
+  // Like the Qt messages, written in the logs collection too.
+  QMutexLocker locker(&mMutex);
+  ::writeLine(level, nullptr, nullptr, context, summary);
+  bctbx_log(QT_DOMAIN, static_cast<BctbxLogLevel>(level), "QT: %s%s", context ? context : "", summary);
+}
+
+// -----------------------------------------------------------------------------
+
+const QByteArray &Logger::formatLine (
+  int level,
+  const char *domain,
+  const void *thread,
+  const char *context,
+  const char *message
+) {
+  LogBuffers &buffers = ::getLogBuffers();
+  const LevelInfo *levelInfo = ::getLevelInfo(level);
+  Q_CHECK_PTR(levelInfo);
+
+  QByteArray &line = buffers.line;
+  line.resize(0);
+
+  line.append(levelInfo->color).append('[').append(::getFormattedCurrentTime(buffers)).append(']');
+  if (thread) {
+    char threadStr[32];
+    snprintf(threadStr, sizeof threadStr, "[%p]", thread);
+    line.append(threadStr);
+  }
+  // Qt critical messages are forwarded as core errors but keep their own name.
+  line.append('[').append(!domain && level == BCTBX_LOG_ERROR ? "Critical" : levelInfo->name).append(']');
+
+  if (domain)
+    line.append(YELLOW "Core:").append(domain).append(": ");
+  else
+    line.append(PURPLE).append(context ? context : "");
+
+  line.append(RESET).append(message).append('\n');
+
+  return line;
+}
+
+// -----------------------------------------------------------------------------
+
+bool Logger::setLogLevel (const QString &domain, const QString &level) {
+  const QString name = domain.trimmed();
+  const int value = ::getLevelFromId(level);
+  if (name.isEmpty() || value == -1) {
+    qWarning() << QStringLiteral("Invalid log level: `%1=%2`.").arg(domain).arg(level);
+    return false;
+  }
+
+  qInfo() << QStringLiteral("Set log level of `%1` to `%2`.").arg(name).arg(::getLevelInfo(value)->id);
+
+  mLogLevels[name] = value;
+  applyLogLevel(name, value);
+  if (::isQtCategory(name))
+    updateQtFilterRules();
+
+  return true;
+}
+
+bool Logger::setLogLevels (const QString &levels) {
+  // Parse all levels before applying them, an invalid spec must not be partially applied.
+  QMap<QString, int> newLogLevels;
+  for (const auto &entry : levels.split(',', QString::SkipEmptyParts)) {
+    const QStringList parts = entry.split('=');
+    const int value = parts.size() == 2 ? ::getLevelFromId(parts[1]) : -1;
+    const QString name = parts[0].trimmed();
+    if (name.isEmpty() || value == -1) {
+      qWarning() << QStringLiteral("Invalid log level: `%1`.").arg(entry);
+      return false;
+    }
+
+    newLogLevels[name] = value;
+  }
+
+  // Reset domains which are no longer listed.
+  const int defaultLevel = newLogLevels.value("*", DEFAULT_LOG_LEVEL);
+  for (auto it = mLogLevels.cbegin(); it != mLogLevels.cend(); ++it)
+    if (!newLogLevels.contains(it.key()))
+      applyLogLevel(it.key(), it.key() == "*" ? DEFAULT_LOG_LEVEL : defaultLevel);
+
+  mLogLevels = newLogLevels;
+  for (auto it = mLogLevels.cbegin(); it != mLogLevels.cend(); ++it)
+    applyLogLevel(it.key(), it.value());
+  updateQtFilterRules();
+
+  return true;
+}
+
+QString Logger::getLogLevels () const {
+  QStringList levels;
+  for (auto it = mLogLevels.cbegin(); it != mLogLevels.cend(); ++it)
+    levels << QStringLiteral("%1=%2").arg(it.key()).arg(::getLevelInfo(it.value())->id);
+  return levels.join(',');
+}
+
+void Logger::applyLogLevel (const QString &domain, int level) {
+  // Disabled levels are filtered by bctoolbox before any formatting.
+  if (domain == "*")
+    bctbx_set_log_level(nullptr, static_cast<BctbxLogLevel>(level));
+  else if (domain == QT_DOMAIN)
+    // Qt messages are also forwarded to the core logger to be written in the logs collection.
+    bctbx_set_log_level(QT_DOMAIN, static_cast<BctbxLogLevel>(level));
+  else if (!::isQtCategory(domain))
+    bctbx_set_log_level(domain.toLocal8Bit().constData(), static_cast<BctbxLogLevel>(level));
+}
+
+// Qt categories are filtered with rules, so `qCDebug` & co are not evaluated
+// for disabled levels and app messages (default category) are dropped before
+// reaching our handler.
+void Logger::updateQtFilterRules () {
+  QStringList rules;
+
+  for (auto it = mLogLevels.cbegin(); it != mLogLevels.cend(); ++it) {
+    if (!::isQtCategory(it.key()))
+      continue;
+
+    const QString category = it.key() == QT_DOMAIN ? QStringLiteral(QT_DEFAULT_CATEGORY) : it.key();
+    const int level = it.value();
+
+    rules << QStringLiteral("%1.debug=%2").arg(category).arg(level <= BCTBX_LOG_TRACE ? "true" : "false");
+    rules << QStringLiteral("%1.info=%2").arg(category).arg(level <= BCTBX_LOG_MESSAGE ? "true" : "false");
+    rules << QStringLiteral("%1.warning=%2").arg(category).arg(level <= BCTBX_LOG_WARNING ? "true" : "false");
+    rules << QStringLiteral("%1.critical=%2").arg(category).arg(level <= BCTBX_LOG_ERROR ? "true" : "false");
+  }
+
+  QLoggingCategory::setFilterRules(rules.join('\n'));
+}
+
+// -----------------------------------------------------------------------------
+
+void Logger::initRateLimits (const shared_ptr<linphone::Config> &config) {
+  mDefaultRateLimit.burst = config
+    ? config->getInt(SettingsModel::UI_SECTION, "logs_rate_limit_burst", DEFAULT_RATE_LIMIT_BURST)
+    : DEFAULT_RATE_LIMIT_BURST;
+  mDefaultRateLimit.interval = config
+    ? config->getInt(SettingsModel::UI_SECTION, "logs_rate_limit_interval", DEFAULT_RATE_LIMIT_INTERVAL)
+    : DEFAULT_RATE_LIMIT_INTERVAL;
+
+  mRateLimitTimer.start();
+
+  if (config)
+    setRateLimits(::Utils::coreStringToAppString(
+      config->getString(SettingsModel::UI_SECTION, "logs_rate_limits", "")
+    ));
+}
+
+void Logger::setRateLimits (const QString &overrides) {
+  QHash<QByteArray, RateLimit> rateLimits;
+  for (const auto &entry : overrides.split(',', QString::SkipEmptyParts)) {
+    const QStringList parts = entry.trimmed().split('=');
+    const QStringList values = parts.size() == 2 ? parts[1].split('/') : QStringList();
+
+    bool soFarSoGood = values.size() == 1 || values.size() == 2;
+    RateLimit rateLimit = mDefaultRateLimit;
+    if (soFarSoGood)
+      rateLimit.burst = values[0].toInt(&soFarSoGood);
+    if (soFarSoGood && values.size() == 2)
+      rateLimit.interval = values[1].toInt(&soFarSoGood);
+
+    if (!soFarSoGood) {
+      qWarning() << QStringLiteral("Invalid log rate limit: `%1`.").arg(entry);
+      continue;
+    }
+
+    QString name = parts[0].trimmed().toLower();
+    if (name.endsWith(":info"))
+      name.replace(name.length() - 4, 4, "message");
+    rateLimits[name.toLocal8Bit()] = rateLimit;
+  }
+
+  // Not locked while parsing: the warnings are rate limited too.
+  QMutexLocker locker(&mRateLimitMutex);
+  mRateLimits.swap(rateLimits);
+  mResolvedRateLimits.clear();
+}
+
+QString Logger::getRateLimits () const {
+  QStringList rateLimits;
+  for (auto it = mRateLimits.cbegin(); it != mRateLimits.cend(); ++it)
+    rateLimits << QStringLiteral("%1=%2/%3")
+      .arg(QString::fromLocal8Bit(it.key())).arg(it->burst).arg(it->interval);
+  rateLimits.sort();
+  return rateLimits.join(',');
+}
+
+Logger::RateLimit Logger::getRateLimit (const char *domain, int level) {
+  const quint64 key = ::hashValue(::hashBytes(FNV_OFFSET_BASIS, domain), static_cast<quint64>(level));
+
+  auto it = mResolvedRateLimits.find(key);
+  if (it != mResolvedRateLimits.end())
+    return *it;
+
+  // Find the most specific limit. Domain and level, domain, any domain and level, default.
+  // Warnings and errors are only limited by the level overrides, they are never
+  // hidden by default.
+  const LevelInfo *levelInfo = ::getLevelInfo(level);
+  const QByteArray levelName = QByteArray(":") + (levelInfo ? levelInfo->id : "unknown");
+  RateLimit rateLimit;
+  if (level >= BCTBX_LOG_WARNING) {
+    const RateLimit unlimited = { 0, mDefaultRateLimit.interval };
+    rateLimit = mRateLimits.value(domain + levelName, mRateLimits.value("*" + levelName, unlimited));
+  } else
+    rateLimit = mRateLimits.value(
+      domain + levelName, mRateLimits.value(
+        domain, mRateLimits.value("*" + levelName, mDefaultRateLimit)
+      )
+    );
+
+  mResolvedRateLimits[key] = rateLimit;
+  return rateLimit;
+}
+
+void Logger::setRateLimitEnabled (bool status) {
+  QMutexLocker locker(&mRateLimitMutex);
+  mRateLimitEnabled = status;
+}
+
+bool Logger::checkRateLimit (const char *domain, int level, quint64 key, const char *context, int &suppressed) {
+  suppressed = 0;
+
+  // Never hide a fatal error.
+  if (level == BCTBX_LOG_FATAL)
+    return true;
+
+  QMutexLocker locker(&mRateLimitMutex);
+  if (!mRateLimitEnabled)
+    return true;
+
+  const RateLimit rateLimit = getRateLimit(domain, level);
+  if (rateLimit.burst <= 0)
+    return true;
+
+  key = ::hashValue(key, static_cast<quint64>(level));
+  if (mRateLimitStates.size() >= MAX_RATE_LIMIT_STATES && !mRateLimitStates.contains(key)) {
+    // Keep the counts of the released states, they are logged by the next flush.
+    for (const auto &state : mRateLimitStates)
+      if (state.suppressed)
+        mPendingRateLimitSummaries << state;
+    mRateLimitStates.clear();
+  }
+
+  RateLimitState &state = mRateLimitStates[key];
+  if (state.domain.isEmpty()) {
+    state.domain = domain;
+    state.level = level;
+    state.context = context;
+  }
+  state.interval = rateLimit.interval;
+  const qint64 now = mRateLimitTimer.elapsed();
+  if (now - state.windowStart >= rateLimit.interval) {
+    suppressed = state.suppressed;
+
+    state.windowStart = now;
+    state.count = 0;
+    state.suppressed = 0;
+  }
+
+  if (++state.count > rateLimit.burst) {
+    ++state.suppressed;
+    return false;
+  }
+
+  return true;
+}
+
+void Logger::flushRateLimits () {
+  QList<RateLimitState> summaries;
+
+  {
+    QMutexLocker locker(&mRateLimitMutex);
+    summaries.swap(mPendingRateLimitSummaries);
+
+    // A call site without message during its last interval is released.
+    const qint64 now = mRateLimitTimer.elapsed();
+    for (auto it = mRateLimitStates.begin(); it != mRateLimitStates.end(); ) {
+      if (now - it->windowStart < it->interval) {
+        ++it;
+        continue;
+      }
+
+      if (it->suppressed)
+        summaries << *it;
+      it = mRateLimitStates.erase(it);
+    }
+  }
+
+  for (const auto &state : summaries)
+    logRateLimitSummary(state.domain.constData(), state.level, state.context.constData(), state.suppressed);
+}
+
 // -----------------------------------------------------------------------------
 
 void Logger::enable (bool status) {
   linphone_core_enable_log_collection(status ? LinphoneLogCollectionEnabled : LinphoneLogCollectionDisabled);
+  ::installRateLimitedLog();
 }
 
 void Logger::init (const shared_ptr<linphone::Config> &config) {
@@ -167,6 +705,20 @@ void Logger::init (const shared_ptr<linphone::Config> &config) {
   Q_ASSERT(!folder.isEmpty());
 
   mInstance = new Logger();
+  mInstance->initRateLimits(config);
+
+  // Report the floods which stopped, until the end of the app.
+  if (QCoreApplication::instance()) {
+    QTimer *timer = new QTimer(QCoreApplication::instance());
+    timer->setInterval(RATE_LIMIT_FLUSH_INTERVAL);
+    QObject::connect(timer, &QTimer::timeout, timer, [] {
+      mInstance->flushRateLimits();
+    });
+    QObject::connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, timer, [] {
+      mInstance->flushRateLimits();
+    });
+    timer->start();
+  }
 
   qInstallMessageHandler(Logger::log);
 
@@ -176,6 +728,8 @@ void Logger::init (const shared_ptr<linphone::Config> &config) {
         ::linphoneLog(domain, type, fmt, args);
     });
 
+  mInstance->setLogLevels(SettingsModel::getLogsLevels(config));
+
   linphone_core_set_log_collection_path(::Utils::appStringToCoreString(folder).c_str());
 
   linphone_core_set_log_collection_max_file_size(MAX_LOGS_COLLECTION_SIZE);
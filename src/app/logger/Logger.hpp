@@ -24,6 +24,10 @@
 #define LOGGER_H_
 
 #include <linphone++/linphone.hh>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QMap>
 #include <QMutex>
 
 // =============================================================================
@@ -42,6 +46,49 @@ public:
 
   void enable (bool status);
 
+  // Minimum level of a log domain, changed at runtime. A domain is a core
+  // domain (belle-sip, mediastreamer, ortp...), `*` for all core domains,
+  // `qt` for the app messages or a Qt logging category (qt.qml.binding...).
+  // Levels: debug, trace, message (or info), warning, error, fatal.
+  bool setLogLevel (const QString &domain, const QString &level);
+
+  // Set all levels at once. Format: `domain=level`, comma separated.
+  // Domains not listed are reset to the default level.
+  bool setLogLevels (const QString &levels);
+  QString getLogLevels () const;
+
+  // Disabled by the benchmarks, to measure the full path of each message.
+  void setRateLimitEnabled (bool status);
+
+  // Overrides of the default rate limit, like the `logs_rate_limits` config entry.
+  // Format: `domain[:level]=burst[/interval]`, comma separated. Invalid entries are ignored.
+  void setRateLimits (const QString &overrides);
+  QString getRateLimits () const;
+
+  // Returns false if the message must be dropped.
+  // Otherwise `suppressed` is set to the number of messages dropped
+  // from the same call site since the last logged one.
+  // `context` is the call site of Qt messages, used in the summaries.
+  bool checkRateLimit (const char *domain, int level, quint64 key, const char *context, int &suppressed);
+
+  // Logs a summary for each call site which dropped messages and is now
+  // quiet. Called periodically, so a stopped flood is always reported.
+  void flushRateLimits ();
+
+  // Formats a log line in a per-thread buffer. The result is valid until
+  // the next call on the same thread.
+  // `domain` is set for core messages, `thread` and `context` for Qt messages.
+  static const QByteArray &formatLine (
+    int level,
+    const char *domain,
+    const void *thread,
+    const char *context,
+    const char *message
+  );
+
+  // Writes "N similar messages suppressed" at the place of the dropped messages.
+  static void logRateLimitSummary (const char *domain, int level, const char *context, int suppressed);
+
   static void init (const std::shared_ptr<linphone::Config> &config);
 
   static Logger *getInstance () {
@@ -51,10 +98,44 @@ public:
 private:
   Logger () = default;
 
+  struct RateLimit {
+    int burst; // Max messages per call site and per interval. 0 = unlimited.
+    int interval; // In milliseconds.
+  };
+
+  struct RateLimitState {
+    qint64 windowStart = 0;
+    int interval = 0;
+    int count = 0;
+    int suppressed = 0;
+
+    // Where to write the summary.
+    QByteArray domain;
+    int level = 0;
+    QByteArray context;
+  };
+
   static void log (QtMsgType type, const QMessageLogContext &context, const QString &msg);
 
+  void applyLogLevel (const QString &domain, int level);
+  void updateQtFilterRules ();
+
+  void initRateLimits (const std::shared_ptr<linphone::Config> &config);
+  RateLimit getRateLimit (const char *domain, int level);
+
   bool mVerbose = false;
 
+  QMap<QString, int> mLogLevels;
+
+  bool mRateLimitEnabled = true;
+  RateLimit mDefaultRateLimit;
+  QHash<QByteArray, RateLimit> mRateLimits;
+  QHash<quint64, RateLimit> mResolvedRateLimits;
+  QHash<quint64, RateLimitState> mRateLimitStates;
+  QList<RateLimitState> mPendingRateLimitSummaries;
+  QElapsedTimer mRateLimitTimer;
+  QMutex mRateLimitMutex;
+
   static QMutex mMutex;
   static Logger *mInstance;
 };
@@ -35,6 +35,7 @@
 #define PATH_ASSISTANT_CONFIG "/linphone/assistant/"
 #define PATH_AVATARS "/avatars/"
 #define PATH_CAPTURES "/Linphone/captures/"
+#define PATH_IMAGES_CACHE "/images/"
 #define PATH_LOGS "/logs/"
 #define PATH_PLUGINS "/plugins/"
 #define PATH_THUMBNAILS "/thumbnails/"
@@ -48,6 +49,11 @@
 #define PATH_MESSAGE_HISTORY_LIST "/message-history.db"
 #define PATH_ZRTP_SECRETS "/zidcache"
 
+// Runs the app on another profile, e.g. a generated dataset.
+// See `src/tools/dataset-generator`.
+#define PROFILE_DIR_ENV_VAR "LINPHONE_PROFILE_DIR"
+#define PATH_PROFILE_CACHE "/cache"
+
 using namespace std;
 
 // =============================================================================
@@ -101,6 +107,30 @@ static inline string getWritableFilePath (const QString &filename) {
 
 // -----------------------------------------------------------------------------
 
+static inline QString getProfileDirPath () {
+  static const QString path = QString::fromLocal8Bit(qgetenv(PROFILE_DIR_ENV_VAR));
+  return path.isEmpty() ? path : QDir(path).absolutePath();
+}
+
+// The config, the data and the cache are stored in the profile directory if it is set.
+static inline QString getWritableLocation (QStandardPaths::StandardLocation type) {
+  const QString profileDirPath = ::getProfileDirPath();
+  if (!profileDirPath.isEmpty())
+    switch (type) {
+      case QStandardPaths::AppConfigLocation:
+      case QStandardPaths::AppLocalDataLocation:
+        return profileDirPath;
+      case QStandardPaths::CacheLocation:
+        return profileDirPath + PATH_PROFILE_CACHE;
+      default:
+        break;
+    }
+
+  return QStandardPaths::writableLocation(type);
+}
+
+// -----------------------------------------------------------------------------
+
 static inline QDir getAppPackageDir () {
   QDir dir(QCoreApplication::applicationDirPath());
   if (dir.dirName() == "MacOS") {
@@ -128,11 +158,11 @@ static inline QString getAppAssistantConfigDirPath () {
 }
 
 static inline QString getAppConfigFilePath () {
-  return QStandardPaths::writableLocation(QStandardPaths::AppConfigLocation) + PATH_CONFIG;
+  return ::getWritableLocation(QStandardPaths::AppConfigLocation) + PATH_CONFIG;
 }
 
 static inline QString getAppCallHistoryFilePath () {
-  return QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + PATH_CALL_HISTORY_LIST;
+  return ::getWritableLocation(QStandardPaths::AppLocalDataLocation) + PATH_CALL_HISTORY_LIST;
 }
 
 static inline QString getAppFactoryConfigFilePath () {
@@ -148,11 +178,11 @@ static inline QString getAppRootCaFilePath () {
 }
 
 static inline QString getAppFriendsFilePath () {
-  return QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + PATH_FRIENDS_LIST;
+  return ::getWritableLocation(QStandardPaths::AppLocalDataLocation) + PATH_FRIENDS_LIST;
 }
 
 static inline QString getAppMessageHistoryFilePath () {
-  return QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + PATH_MESSAGE_HISTORY_LIST;
+  return ::getWritableLocation(QStandardPaths::AppLocalDataLocation) + PATH_MESSAGE_HISTORY_LIST;
 }
 
 // -----------------------------------------------------------------------------
@@ -168,7 +198,7 @@ string Paths::getAssistantConfigDirPath () {
 }
 
 string Paths::getAvatarsDirPath () {
-  return ::getWritableDirPath(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + PATH_AVATARS);
+  return ::getWritableDirPath(::getWritableLocation(QStandardPaths::AppLocalDataLocation) + PATH_AVATARS);
 }
 
 string Paths::getCallHistoryFilePath () {
@@ -176,7 +206,7 @@ string Paths::getCallHistoryFilePath () {
 }
 
 string Paths::getCapturesDirPath () {
-  return ::getWritableDirPath(QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation) + PATH_CAPTURES);
+  return ::getWritableDirPath(::getWritableLocation(QStandardPaths::DocumentsLocation) + PATH_CAPTURES);
 }
 
 string Paths::getConfigFilePath (const QString &configPath, bool writable) {
@@ -196,11 +226,15 @@ string Paths::getFriendsListFilePath () {
 }
 
 string Paths::getDownloadDirPath () {
-  return ::getWritableDirPath(QStandardPaths::writableLocation(QStandardPaths::DownloadLocation));
+  return ::getWritableDirPath(::getWritableLocation(QStandardPaths::DownloadLocation));
+}
+
+string Paths::getImagesCacheDirPath () {
+  return ::getWritableDirPath(::getWritableLocation(QStandardPaths::CacheLocation) + PATH_IMAGES_CACHE);
 }
 
 string Paths::getLogsDirPath () {
-  return ::getWritableDirPath(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + PATH_LOGS);
+  return ::getWritableDirPath(::getWritableLocation(QStandardPaths::AppLocalDataLocation) + PATH_LOGS);
 }
 
 string Paths::getMessageHistoryFilePath () {
@@ -219,20 +253,24 @@ string Paths::getPluginsDirPath () {
   return ::getReadableDirPath(::getAppPluginsDirPath());
 }
 
+string Paths::getProfileDirPath () {
+  return ::Utils::appStringToCoreString(QDir::toNativeSeparators(::getProfileDirPath()));
+}
+
 string Paths::getRootCaFilePath () {
   return ::getReadableFilePath(::getAppRootCaFilePath());
 }
 
 string Paths::getThumbnailsDirPath () {
-  return ::getWritableDirPath(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + PATH_THUMBNAILS);
+  return ::getWritableDirPath(::getWritableLocation(QStandardPaths::AppLocalDataLocation) + PATH_THUMBNAILS);
 }
 
 string Paths::getUserCertificatesDirPath () {
-  return ::getWritableDirPath(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + PATH_USER_CERTIFICATES);
+  return ::getWritableDirPath(::getWritableLocation(QStandardPaths::AppLocalDataLocation) + PATH_USER_CERTIFICATES);
 }
 
 string Paths::getZrtpSecretsFilePath () {
-  return ::getWritableFilePath(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + PATH_ZRTP_SECRETS);
+  return ::getWritableFilePath(::getWritableLocation(QStandardPaths::AppLocalDataLocation) + PATH_ZRTP_SECRETS);
 }
 
 // -----------------------------------------------------------------------------
@@ -268,10 +306,14 @@ static void migrateConfigurationFile (const QString &oldPath, const QString &new
 }
 
 void Paths::migrate () {
+  // Never move the files of the user profile in another profile.
+  if (!::getProfileDirPath().isEmpty())
+    return;
+
   QString newPath = ::getAppConfigFilePath();
   QString oldBaseDir = QSysInfo::productType() == "windows"
-    ? QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation)
-    : QStandardPaths::writableLocation(QStandardPaths::HomeLocation);
+    ? ::getWritableLocation(QStandardPaths::AppLocalDataLocation)
+    : ::getWritableLocation(QStandardPaths::HomeLocation);
   QString oldPath = oldBaseDir + "/.linphonerc";
 
   if (!::filePathExists(newPath) && ::filePathExists(oldPath))
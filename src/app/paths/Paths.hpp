@@ -38,11 +38,13 @@ namespace Paths {
   std::string getFactoryConfigFilePath ();
   std::string getFriendsListFilePath ();
   std::string getDownloadDirPath ();
+  std::string getImagesCacheDirPath ();
   std::string getLogsDirPath ();
   std::string getMessageHistoryFilePath ();
   std::string getPackageDataDirPath ();
   std::string getPackageMsPluginsDirPath ();
   std::string getPluginsDirPath ();
+  std::string getProfileDirPath (); // Empty if not set.
   std::string getRootCaFilePath ();
   std::string getThumbnailsDirPath ();
   std::string getUserCertificatesDirPath ();
@@ -20,6 +20,7 @@
  *      Author: Ronan Abhamon
  */
 
+#include "../../utils/ImageScaler.hpp"
 #include "../../utils/Utils.hpp"
 #include "../paths/Paths.hpp"
 
@@ -36,8 +37,16 @@ AvatarProvider::AvatarProvider () : QQuickImageProvider(
   mAvatarsPath = ::Utils::coreStringToAppString(Paths::getAvatarsDirPath());
 }
 
-QImage AvatarProvider::requestImage (const QString &id, QSize *size, const QSize &) {
+QImage AvatarProvider::requestImage (const QString &id, QSize *size, const QSize &requestedSize) {
   QImage image(mAvatarsPath + id);
   *size = image.size();
+
+  // Avatars are cropped: the scaled image must cover the requested size.
+  if (
+    requestedSize.width() > 0 && requestedSize.height() > 0 &&
+    image.width() > requestedSize.width() && image.height() > requestedSize.height()
+  )
+    return ImageScaler::scaled(image, requestedSize, Qt::KeepAspectRatioByExpanding);
+
   return image;
 }
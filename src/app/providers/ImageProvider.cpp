@@ -20,251 +20,457 @@
  *      Author: Ronan Abhamon
  */
 
+#include <QCryptographicHash>
+#include <QDir>
 #include <QElapsedTimer>
 #include <QFileInfo>
+#include <QMetaProperty>
+#include <QMutexLocker>
 #include <QPainter>
+#include <QResource>
+#include <QSaveFile>
 #include <QSvgRenderer>
 
+#include "../../utils/ImageAtlas.hpp"
+#include "../../utils/SvgTemplate.hpp"
+#include "../../utils/Utils.hpp"
 #include "../App.hpp"
+#include "../paths/Paths.hpp"
 
 #include "ImageProvider.hpp"
 
 // Max image size in bytes. (100Kb)
 #define MAX_IMAGE_SIZE 102400
 
+// Max size of cached rasterized images in bytes. (16Mb)
+#define MAX_CACHED_IMAGES_SIZE 16777216
+
+// Max size of cached recolored svg contents in bytes. (2Mb)
+#define MAX_CACHED_CONTENTS_SIZE 2097152
+
+// Must be incremented when the disk cache format or the recoloration change.
+#define DISK_CACHE_VERSION 2
+#define DISK_CACHE_MAGIC "LIMG"
+
+// The oldest files of the disk cache are removed at startup beyond this number of files.
+#define MAX_DISK_CACHE_FILES 4096
+
+// Built by the images compiler. See `assets/images/CMakeLists.txt`.
+#define IMAGES_TEMPLATES_PATH ":/assets/images-compiled/%1"
+#define IMAGES_ATLAS_PATH ":/assets/images-compiled/atlas"
+
 using namespace std;
 
 // =============================================================================
 
-static void removeAttribute (QXmlStreamAttributes &readerAttributes, const QString &name) {
-  auto it = find_if(readerAttributes.cbegin(), readerAttributes.cend(), [&name](const QXmlStreamAttribute &attribute) {
-        return name == attribute.name() && !attribute.prefix().length();
-      });
-  if (it != readerAttributes.cend())
-    readerAttributes.remove(static_cast<int>(distance(readerAttributes.cbegin(), it)));
-}
+static QStringList getColorNames () {
+  QStringList colorNames;
 
-static QByteArray buildByteArrayAttribute (const QByteArray &name, const QByteArray &value) {
-  QByteArray attribute = name;
-  attribute.append("=\"");
-  attribute.append(value);
-  attribute.append("\" ");
-  return attribute;
+  const QMetaObject &info = Colors::staticMetaObject;
+  for (int i = info.propertyOffset(); i < info.propertyCount(); ++i) {
+    const QMetaProperty metaProperty = info.property(i);
+    if (metaProperty.userType() == QMetaType::QColor)
+      colorNames << QString::fromLatin1(metaProperty.name());
+  }
+
+  return colorNames;
 }
 
-static QByteArray parseFillAndStroke (QXmlStreamAttributes &readerAttributes, const Colors &colors) {
-  static QRegExp regex("^color-([^-]+)-(fill|stroke)$");
+// Svg values of the colors, by property index.
+static QVector<QByteArray> computeColorValues (const Colors &colors) {
+  const QMetaObject &info = Colors::staticMetaObject;
+
+  QVector<QByteArray> colorValues(info.propertyCount() - info.propertyOffset());
+  for (int i = info.propertyOffset(); i < info.propertyCount(); ++i) {
+    const QMetaProperty metaProperty = info.property(i);
+    if (metaProperty.userType() == QMetaType::QColor)
+      colorValues[i - info.propertyOffset()] = metaProperty.read(&colors).value<QColor>().name().toLatin1();
+  }
 
-  QByteArray attributes;
+  return colorValues;
+}
 
-  for (const auto &classValue : readerAttributes.value("class").toLatin1().split(' ')) {
-    regex.indexIn(classValue.trimmed());
-    if (Q_LIKELY(regex.pos() == -1))
-      continue;
+static bool isAtlasUsable (const ImageAtlas &atlas, const Colors &colors) {
+  if (atlas.isNull())
+    return false;
 
-    const QStringList list = regex.capturedTexts();
+  for (auto it = atlas.getColors().cbegin(); it != atlas.getColors().cend(); ++it)
+    if (colors.property(it.key().toLatin1().constData()).value<QColor>().name() != *it)
+      return false;
 
-    const QVariant colorValue = colors.property(list[1].toStdString().c_str());
-    if (Q_UNLIKELY(!colorValue.isValid())) {
-      qWarning() << QStringLiteral("Color name `%1` does not exist.").arg(list[1]);
-      continue;
-    }
+  return true;
+}
 
-    ::removeAttribute(readerAttributes, list[2]);
-    attributes.append(::buildByteArrayAttribute(list[2].toLatin1(), colorValue.value<QColor>().name().toLatin1()));
+static ImageAtlas loadAtlas () {
+  // The atlas is stored uncompressed in the resources, so its pixels are
+  // used in place. Resources data stay valid until the end of the app.
+  QResource resource(QStringLiteral(IMAGES_ATLAS_PATH));
+  if (!resource.isValid() || resource.isCompressed()) {
+    qWarning() << QStringLiteral("Unable to open images atlas.");
+    return ImageAtlas();
   }
 
-  return attributes;
+  const ImageAtlas atlas = ImageAtlas::fromData(QByteArray::fromRawData(
+    reinterpret_cast<const char *>(resource.data()), static_cast<int>(resource.size())
+  ));
+  if (atlas.isNull())
+    qWarning() << QStringLiteral("Invalid images atlas.");
+
+  return atlas;
 }
 
-static QByteArray parseStyle (QXmlStreamAttributes &readerAttributes, const Colors &colors) {
-  static QRegExp regex("^color-([^-]+)-style-(fill|stroke)$");
+// Fallback if the image was not compiled at build time.
+static SvgTemplate compileTemplate (const QString &path) {
+  QFile file(path);
+  if (Q_UNLIKELY(QFileInfo(file).size() > MAX_IMAGE_SIZE)) {
+    qWarning() << QStringLiteral("Unable to open large file: `%1`.").arg(path);
+    return SvgTemplate();
+  }
 
-  QByteArray attribute;
+  if (Q_UNLIKELY(!file.open(QIODevice::ReadOnly))) {
+    qWarning() << QStringLiteral("Unable to open file: `%1`.").arg(path);
+    return SvgTemplate();
+  }
 
-  QSet<QString> overrode;
-  for (const auto &classValue : readerAttributes.value("class").toLatin1().split(' ')) {
-    regex.indexIn(classValue.trimmed());
-    if (Q_LIKELY(regex.pos() == -1))
-      continue;
+  const SvgTemplate svgTemplate = SvgTemplate::compile(file, ::getColorNames());
+  if (Q_UNLIKELY(svgTemplate.isNull()))
+    qWarning() << QStringLiteral("Unable to parse file: `%1`.").arg(path);
 
-    const QStringList list = regex.capturedTexts();
+  return svgTemplate;
+}
 
-    overrode.insert(list[2]);
+// -----------------------------------------------------------------------------
+// Disk cache. Raw ARGB32 pixels preceded by a small header, mapped in memory
+// when loaded.
+// -----------------------------------------------------------------------------
 
-    const QVariant colorValue = colors.property(list[1].toStdString().c_str());
-    if (Q_UNLIKELY(!colorValue.isValid())) {
-      qWarning() << QStringLiteral("Color name `%1` does not exist.").arg(list[1]);
-      continue;
-    }
+namespace {
+  struct DiskCacheHeader {
+    char magic[4];
+    quint32 version;
+    qint32 width;
+    qint32 height;
+    qint32 bytesPerLine;
+    qint32 format;
+  };
+}
 
-    attribute.append(list[2].toLatin1());
-    attribute.append(":");
-    attribute.append(colorValue.value<QColor>().name().toLatin1());
-    attribute.append(";");
+static QImage loadDiskCacheImage (const QString &path) {
+  QFile *file = new QFile(path);
+  if (!file->open(QIODevice::ReadOnly) || file->size() < qint64(sizeof(DiskCacheHeader))) {
+    delete file;
+    return QImage();
   }
 
-  const QByteArrayList styleValues = readerAttributes.value("style").toLatin1().split(';');
-  for (const auto &styleValue : styleValues) {
-    const QByteArrayList list = styleValue.split(':');
-    if (Q_UNLIKELY(list.length() > 0 && !overrode.contains(list[0]))) {
-      attribute.append(styleValue);
-      attribute.append(";");
-    }
+  const uchar *data = file->map(0, file->size());
+  if (!data) {
+    delete file;
+    return QImage();
   }
 
-  ::removeAttribute(readerAttributes, "style");
-
-  if (attribute.length() > 0) {
-    attribute.prepend("style=\"");
-    attribute.append("\" ");
+  const DiskCacheHeader *header = reinterpret_cast<const DiskCacheHeader *>(data);
+  if (
+    strncmp(header->magic, DISK_CACHE_MAGIC, sizeof header->magic) ||
+    header->version != DISK_CACHE_VERSION ||
+    header->format != QImage::Format_ARGB32 ||
+    header->width <= 0 ||
+    header->height <= 0 ||
+    header->bytesPerLine < qint64(header->width) * 4 ||
+    header->bytesPerLine % 4 ||
+    file->size() != qint64(sizeof(DiskCacheHeader)) + qint64(header->bytesPerLine) * header->height
+  ) {
+    qWarning() << QStringLiteral("Invalid image in disk cache: `%1`.").arg(path);
+    delete file;
+    QFile::remove(path);
+    return QImage();
   }
 
-  return attribute;
+  // The file is unmapped and closed when the last copy of the image is destroyed.
+  // The mapping is read-only: the image is detached before any write.
+  return QImage(
+    data + sizeof(DiskCacheHeader),
+    header->width,
+    header->height,
+    header->bytesPerLine,
+    QImage::Format_ARGB32,
+    [](void *file) {
+      delete static_cast<QFile *>(file);
+    },
+    file
+  );
 }
 
-static QByteArray parseAttributes (const QXmlStreamReader &reader, const Colors &colors) {
-  QXmlStreamAttributes readerAttributes = reader.attributes();
+static void saveDiskCacheImage (const QString &path, const QImage &image) {
+  DiskCacheHeader header;
+  memcpy(header.magic, DISK_CACHE_MAGIC, sizeof header.magic);
+  header.version = DISK_CACHE_VERSION;
+  header.width = image.width();
+  header.height = image.height();
+  header.bytesPerLine = image.bytesPerLine();
+  header.format = image.format();
+
+  QSaveFile file(path);
+  if (
+    !file.open(QIODevice::WriteOnly) ||
+    file.write(reinterpret_cast<const char *>(&header), sizeof header) != qint64(sizeof header) ||
+    file.write(reinterpret_cast<const char *>(image.constBits()), header.bytesPerLine * header.height) !=
+    qint64(header.bytesPerLine) * header.height ||
+    !file.commit()
+  )
+    qWarning() << QStringLiteral("Unable to write image in disk cache: `%1`.").arg(path);
+}
 
-  QByteArray attributes = ::parseFillAndStroke(readerAttributes, colors);
-  attributes.append(::parseStyle(readerAttributes, colors));
+static void pruneDiskCache (const QString &dirPath) {
+  QDir dir(dirPath);
 
-  for (const auto &attribute : readerAttributes) {
-    const QByteArray prefix = attribute.prefix().toLatin1();
-    if (Q_UNLIKELY(prefix.length() > 0)) {
-      attributes.append(prefix);
-      attributes.append(":");
-    }
+  // Most recently written first.
+  const QStringList files = dir.entryList(QDir::Files, QDir::Time);
+  if (files.count() <= MAX_DISK_CACHE_FILES)
+    return;
+
+  qInfo() << QStringLiteral("Prune images disk cache: `%1` (%2 files, %3 removed).")
+    .arg(dirPath).arg(files.count()).arg(files.count() - MAX_DISK_CACHE_FILES);
+  for (int i = MAX_DISK_CACHE_FILES; i < files.count(); ++i)
+    dir.remove(files[i]);
+}
+
+// Stable across runs, unlike `qHash`.
+static QByteArray computeColorsHash (const Colors &colors) {
+  QCryptographicHash hash(QCryptographicHash::Md5);
 
-    attributes.append(
-      ::buildByteArrayAttribute(attribute.name().toLatin1(), attribute.value().toLatin1())
-    );
+  const QMetaObject *info = colors.metaObject();
+  for (int i = info->propertyOffset(); i < info->propertyCount(); ++i) {
+    const QRgb rgba = info->property(i).read(&colors).value<QColor>().rgba();
+    hash.addData(reinterpret_cast<const char *>(&rgba), sizeof rgba);
   }
 
-  return attributes;
+  return hash.result().toHex();
 }
 
-static QByteArray parseDeclarations (const QXmlStreamReader &reader) {
-  QByteArray declarations;
-  for (const auto &declaration : reader.namespaceDeclarations()) {
-    const QByteArray prefix = declaration.prefix().toLatin1();
-    if (Q_UNLIKELY(prefix.length() > 0)) {
-      declarations.append("xmlns:");
-      declarations.append(prefix);
-    } else
-      declarations.append("xmlns");
-
-    declarations.append("=\"");
-    declarations.append(declaration.namespaceUri().toLatin1());
-    declarations.append("\" ");
-  }
+static QByteArray computeResourceHash (const QString &path) {
+  // Raw resource data, possibly compressed. No copy.
+  QResource resource(path);
+  if (!resource.isValid())
+    return QByteArray();
 
-  return declarations;
+  return QCryptographicHash::hash(
+    QByteArray::fromRawData(reinterpret_cast<const char *>(resource.data()), static_cast<int>(resource.size())),
+    QCryptographicHash::Md5
+  ).toHex();
 }
 
-static QByteArray parseStartDocument (const QXmlStreamReader &reader) {
-  QByteArray startDocument = "<?xml version=\"";
-  startDocument.append(reader.documentVersion().toLatin1());
-  startDocument.append("\" encoding=\"");
-  startDocument.append(reader.documentEncoding().toLatin1());
-  startDocument.append("\"?>");
-  return startDocument;
+// -----------------------------------------------------------------------------
+
+const QString ImageProvider::PROVIDER_ID = "internal";
+
+ImageProvider::Cache ImageProvider::mCache;
+QMutex ImageProvider::mCacheMutex;
+
+ImageProvider::ImageProvider () : QQuickImageProvider(
+    QQmlImageProviderBase::Image,
+    QQmlImageProviderBase::ForceAsynchronousImageLoading
+  ) {
+  mDiskCachePath = ::Utils::coreStringToAppString(Paths::getImagesCacheDirPath());
+  mDevicePixelRatio = qApp->devicePixelRatio();
+  ::pruneDiskCache(mDiskCachePath);
+
+  QMutexLocker locker(&mCacheMutex);
+  mCache.images.setMaxCost(MAX_CACHED_IMAGES_SIZE);
+  mCache.contents.setMaxCost(MAX_CACHED_CONTENTS_SIZE);
+  if (mCache.atlas.isNull())
+    mCache.atlas = ::loadAtlas();
 }
 
-static QByteArray parseStartElement (const QXmlStreamReader &reader, const Colors &colors) {
-  QByteArray startElement = "<";
-  startElement.append(reader.name().toLatin1());
-  startElement.append(" ");
-  startElement.append(::parseAttributes(reader, colors));
-  startElement.append(" ");
-  startElement.append(::parseDeclarations(reader));
-  startElement.append(">");
-  return startElement;
+// -----------------------------------------------------------------------------
+
+QVariantMap ImageProvider::getCacheStatistics () {
+  QMutexLocker locker(&mCacheMutex);
+
+  QVariantMap statistics;
+  statistics["imageHits"] = mCache.imageHits;
+  statistics["imageMisses"] = mCache.imageMisses;
+  statistics["imageCount"] = mCache.images.count();
+  statistics["imageSize"] = mCache.images.totalCost();
+  statistics["contentHits"] = mCache.contentHits;
+  statistics["contentMisses"] = mCache.contentMisses;
+  statistics["contentCount"] = mCache.contents.count();
+  statistics["contentSize"] = mCache.contents.totalCost();
+  statistics["diskHits"] = mCache.diskHits;
+  statistics["diskMisses"] = mCache.diskMisses;
+  statistics["atlasHits"] = mCache.atlasHits;
+  statistics["templateCount"] = mCache.templates.count();
+  return statistics;
 }
 
-static QByteArray parseEndElement (const QXmlStreamReader &reader) {
-  QByteArray endElement = "</";
-  endElement.append(reader.name().toLatin1());
-  endElement.append(">");
-  return endElement;
+// -----------------------------------------------------------------------------
+
+QString ImageProvider::getDiskCacheFilePath (const QString &id, const QString &path, const QSize &requestedSize) const {
+  const QByteArray resourceHash = ::computeResourceHash(path);
+  if (resourceHash.isEmpty())
+    return QString("");
+
+  QByteArray colorsHash;
+  {
+    QMutexLocker locker(&mCacheMutex);
+    colorsHash = mCache.colorsHash;
+  }
+
+  const QString key = QStringLiteral("%1:%2:%3:%4x%5@%6:%7")
+    .arg(DISK_CACHE_VERSION)
+    .arg(id)
+    .arg(QString::fromLatin1(resourceHash))
+    .arg(requestedSize.width())
+    .arg(requestedSize.height())
+    .arg(mDevicePixelRatio)
+    .arg(QString::fromLatin1(colorsHash));
+
+  return mDiskCachePath + QString::fromLatin1(
+    QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex()
+  );
 }
 
 // -----------------------------------------------------------------------------
 
-static QByteArray computeContent (QFile &file) {
-  const Colors *colors = App::getInstance()->getColors();
-
-  QByteArray content;
-  QXmlStreamReader reader(&file);
-  while (!reader.atEnd())
-    switch (reader.readNext()) {
-      case QXmlStreamReader::Comment:
-      case QXmlStreamReader::DTD:
-      case QXmlStreamReader::EndDocument:
-      case QXmlStreamReader::Invalid:
-      case QXmlStreamReader::NoToken:
-      case QXmlStreamReader::ProcessingInstruction:
-        break;
-
-      case QXmlStreamReader::StartDocument:
-        content.append(::parseStartDocument(reader));
-        break;
-
-      case QXmlStreamReader::StartElement:
-        content.append(::parseStartElement(reader, *colors));
-        break;
-
-      case QXmlStreamReader::EndElement:
-        content.append(::parseEndElement(reader));
-        break;
-
-      case QXmlStreamReader::Characters:
-        content.append(reader.text().toLatin1());
-        break;
-
-      case QXmlStreamReader::EntityReference:
-        content.append(reader.name().toLatin1());
-        break;
+ImageProvider::Template ImageProvider::getTemplate (const QString &id, const QString &path) {
+  {
+    QMutexLocker locker(&mCacheMutex);
+    auto it = mCache.templates.constFind(id);
+    if (it != mCache.templates.cend())
+      return *it;
+  }
+
+  Template imageTemplate;
+
+  QFile file(QStringLiteral(IMAGES_TEMPLATES_PATH).arg(id));
+  if (Q_LIKELY(file.open(QIODevice::ReadOnly))) {
+    imageTemplate.svgTemplate = SvgTemplate::fromData(file.readAll());
+    if (Q_UNLIKELY(imageTemplate.svgTemplate.isNull()))
+      qWarning() << QStringLiteral("Invalid compiled image: `%1`.").arg(file.fileName());
+  }
+
+  if (Q_UNLIKELY(imageTemplate.svgTemplate.isNull())) {
+    imageTemplate.svgTemplate = ::compileTemplate(path);
+    if (imageTemplate.svgTemplate.isNull())
+      return imageTemplate;
+  }
+
+  const QMetaObject &info = Colors::staticMetaObject;
+  for (const auto &colorName : imageTemplate.svgTemplate.getColorNames()) {
+    const int index = info.indexOfProperty(colorName.toLatin1().constData());
+    if (Q_UNLIKELY(index < info.propertyOffset())) {
+      qWarning() << QStringLiteral("Color name `%1` does not exist.").arg(colorName);
+      return Template();
     }
+    imageTemplate.colorIndexes << index - info.propertyOffset();
+  }
 
-  return reader.hasError() ? QByteArray() : content;
+  QMutexLocker locker(&mCacheMutex);
+  mCache.templates.insert(id, imageTemplate);
+  return imageTemplate;
 }
 
-// -----------------------------------------------------------------------------
+QByteArray ImageProvider::getContent (const QString &id, const QString &path, int generation) {
+  {
+    QMutexLocker locker(&mCacheMutex);
+    if (const QByteArray *content = mCache.contents.object(id)) {
+      ++mCache.contentHits;
+      return *content;
+    }
+    ++mCache.contentMisses;
+  }
 
-const QString ImageProvider::PROVIDER_ID = "internal";
+  const Template imageTemplate = getTemplate(id, path);
+  if (Q_UNLIKELY(imageTemplate.svgTemplate.isNull()))
+    return QByteArray();
+
+  // Slots substitution, no xml parsing.
+  QVector<QByteArray> colorValues;
+  colorValues.reserve(imageTemplate.colorIndexes.count());
+  {
+    QMutexLocker locker(&mCacheMutex);
+    for (int index : imageTemplate.colorIndexes)
+      colorValues << mCache.colorValues[index];
+  }
 
-ImageProvider::ImageProvider () : QQuickImageProvider(
-    QQmlImageProviderBase::Image,
-    QQmlImageProviderBase::ForceAsynchronousImageLoading
-  ) {}
+  const QByteArray content = imageTemplate.svgTemplate.instantiate(colorValues);
+
+  QMutexLocker locker(&mCacheMutex);
+  if (mCache.generation == generation)
+    mCache.contents.insert(id, new QByteArray(content), content.size());
+
+  return content;
+}
 
 // -----------------------------------------------------------------------------
 
 QImage ImageProvider::requestImage (const QString &id, QSize *size, const QSize &requestedSize) {
+  const int generation = Colors::getGeneration();
+  const QString key = QStringLiteral("%1:%2x%3")
+    .arg(id).arg(requestedSize.width()).arg(requestedSize.height());
+
+  {
+    QMutexLocker locker(&mCacheMutex);
+    if (mCache.generation != generation) {
+      mCache.images.clear();
+      mCache.contents.clear();
+      mCache.generation = generation;
+
+      const Colors *colors = App::getInstance()->getColors();
+      mCache.colorsHash = ::computeColorsHash(*colors);
+      mCache.colorValues = ::computeColorValues(*colors);
+      mCache.atlasUsable = ::isAtlasUsable(mCache.atlas, *colors);
+    }
+
+    if (const QImage *image = mCache.images.object(key)) {
+      ++mCache.imageHits;
+      *size = image->size();
+      return *image;
+    }
+    ++mCache.imageMisses;
+
+    // Rasterized at build time with the default colors.
+    if (mCache.atlasUsable) {
+      const QImage image = mCache.atlas.getImage(id);
+      if (
+        !image.isNull() &&
+        (requestedSize.width() <= 0 || requestedSize.width() == image.width()) &&
+        (requestedSize.height() <= 0 || requestedSize.height() == image.height())
+      ) {
+        ++mCache.atlasHits;
+        *size = image.size();
+        return image;
+      }
+    }
+  }
+
   const QString path = QStringLiteral(":/assets/images/%1").arg(id);
-  qInfo() << QStringLiteral("Image `%1` requested.").arg(path);
 
-  QElapsedTimer timer;
-  timer.start();
+  // Try to map a previous rasterization. No svg parsing on a warm start.
+  const QString diskCacheFilePath = getDiskCacheFilePath(id, path, requestedSize);
+  if (!diskCacheFilePath.isEmpty()) {
+    const QImage image = ::loadDiskCacheImage(diskCacheFilePath);
 
-  // 1. Read and update XML content.
-  QFile file(path);
-  if (Q_UNLIKELY(QFileInfo(file).size() > MAX_IMAGE_SIZE)) {
-    qWarning() << QStringLiteral("Unable to open large file: `%1`.").arg(path);
-    return QImage();
-  }
+    QMutexLocker locker(&mCacheMutex);
+    if (!image.isNull()) {
+      ++mCache.diskHits;
+      if (mCache.generation == generation)
+        mCache.images.insert(key, new QImage(image), image.bytesPerLine() * image.height());
 
-  if (Q_UNLIKELY(!file.open(QIODevice::ReadOnly))) {
-    qWarning() << QStringLiteral("Unable to open file: `%1`.").arg(path);
-    return QImage();
+      *size = image.size();
+      return image;
+    }
+    ++mCache.diskMisses;
   }
 
-  const QByteArray content = ::computeContent(file);
-  if (Q_UNLIKELY(!content.length())) {
-    qWarning() << QStringLiteral("Unable to parse file: `%1`.").arg(path);
+  qInfo() << QStringLiteral("Image `%1` requested.").arg(path);
+
+  QElapsedTimer timer;
+  timer.start();
+
+  // 1. Recolor the compiled svg.
+  const QByteArray content = getContent(id, path, generation);
+  if (Q_UNLIKELY(!content.length()))
     return QImage();
-  }
 
   // 2. Build svg renderer.
   QSvgRenderer renderer(content);
@@ -292,8 +498,22 @@ QImage ImageProvider::requestImage (const QString &id, QSize *size, const QSize
   *size = image.size();
 
   // 4. Paint!
-  QPainter painter(&image);
-  renderer.render(&painter);
+  {
+    QPainter painter(&image);
+    renderer.render(&painter);
+  }
+
+  // 5. Keep it for the next requests and the next runs if colors are unchanged.
+  {
+    QMutexLocker locker(&mCacheMutex);
+    if (mCache.generation != generation)
+      return image;
+
+    mCache.images.insert(key, new QImage(image), image.bytesPerLine() * image.height());
+  }
+
+  if (!diskCacheFilePath.isEmpty())
+    ::saveDiskCacheImage(diskCacheFilePath, image);
 
   qInfo() << QStringLiteral("Image `%1` loaded in %2 milliseconds.").arg(path).arg(timer.elapsed());
 
@@ -23,7 +23,13 @@
 #ifndef IMAGE_PROVIDER_H_
 #define IMAGE_PROVIDER_H_
 
+#include <QCache>
+#include <QMutex>
 #include <QQuickImageProvider>
+#include <QVariantMap>
+
+#include "../../utils/ImageAtlas.hpp"
+#include "../../utils/SvgTemplate.hpp"
 
 // =============================================================================
 
@@ -34,7 +40,52 @@ public:
 
   QImage requestImage (const QString &id, QSize *size, const QSize &requestedSize) override;
 
+  // Hits, misses and sizes of the rasterized images cache, of the recolored svg cache,
+  // of the disk cache and of the icons atlas.
+  static QVariantMap getCacheStatistics ();
+
   static const QString PROVIDER_ID;
+
+private:
+  // Svg template and its color slots resolved to `Colors` property indexes.
+  struct Template {
+    SvgTemplate svgTemplate;
+    QVector<int> colorIndexes;
+  };
+
+  // Shared by all providers, so the caches survive an engine restart.
+  // Entries are dropped when the colors generation changes, except templates.
+  struct Cache {
+    QCache<QString, QImage> images;
+    QCache<QString, QByteArray> contents;
+    QHash<QString, Template> templates;
+
+    int generation = -1;
+    QByteArray colorsHash;
+    QVector<QByteArray> colorValues;
+
+    ImageAtlas atlas;
+    bool atlasUsable = false;
+
+    int imageHits = 0;
+    int imageMisses = 0;
+    int contentHits = 0;
+    int contentMisses = 0;
+    int diskHits = 0;
+    int diskMisses = 0;
+    int atlasHits = 0;
+  };
+
+  QString getDiskCacheFilePath (const QString &id, const QString &path, const QSize &requestedSize) const;
+
+  static Template getTemplate (const QString &id, const QString &path);
+  static QByteArray getContent (const QString &id, const QString &path, int generation);
+
+  QString mDiskCachePath;
+  qreal mDevicePixelRatio = 1.0;
+
+  static Cache mCache;
+  static QMutex mCacheMutex;
 };
 
 #endif // IMAGE_PROVIDER_H_
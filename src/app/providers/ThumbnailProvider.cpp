@@ -20,24 +20,161 @@
  *      Author: Ronan Abhamon
  */
 
-#include "../../utils/Utils.hpp"
-#include "../paths/Paths.hpp"
+#include <QBuffer>
+#include <QImageReader>
+#include <QMutexLocker>
+#include <QtConcurrent>
 
 #include "ThumbnailProvider.hpp"
+#include "ThumbnailStore.hpp"
+
+// Max size of decoded thumbnails in cache. (16Mb, ~400 thumbnails of 100x100)
+#define MAX_CACHED_THUMBNAILS_SIZE 16777216
 
 // =============================================================================
 
+static inline int computeCost (const QImage &image) {
+  return image.bytesPerLine() * image.height();
+}
+
+// Same semantic as the `sourceSize` of a qml image: a null dimension keeps the ratio.
+static QImage scale (const QImage &image, const QSize &requestedSize) {
+  const int width = requestedSize.width();
+  const int height = requestedSize.height();
+  if (width <= 0)
+    return image.scaledToHeight(height, Qt::SmoothTransformation);
+  if (height <= 0)
+    return image.scaledToWidth(width, Qt::SmoothTransformation);
+  return image.scaled(width, height, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+}
+
+// -----------------------------------------------------------------------------
+
 const QString ThumbnailProvider::PROVIDER_ID = "thumbnail";
 
+ThumbnailProvider::Cache ThumbnailProvider::mCache;
+QMutex ThumbnailProvider::mCacheMutex;
+
 ThumbnailProvider::ThumbnailProvider () : QQuickImageProvider(
     QQmlImageProviderBase::Image,
     QQmlImageProviderBase::ForceAsynchronousImageLoading
   ) {
-  mThumbnailsPath = ::Utils::coreStringToAppString(Paths::getThumbnailsDirPath());
+  QMutexLocker locker(&mCacheMutex);
+  mCache.images.setMaxCost(MAX_CACHED_THUMBNAILS_SIZE);
 }
 
-QImage ThumbnailProvider::requestImage (const QString &id, QSize *size, const QSize &) {
-  QImage image(mThumbnailsPath + id);
+QImage ThumbnailProvider::requestImage (const QString &id, QSize *size, const QSize &requestedSize) {
+  const QImage image = getImage(id, requestedSize);
   *size = image.size();
   return image;
 }
+
+// -----------------------------------------------------------------------------
+
+void ThumbnailProvider::prefetch (const QStringList &ids) {
+  QStringList missingIds;
+  {
+    QMutexLocker locker(&mCacheMutex);
+    for (const auto &id : ids)
+      if (!mCache.images.contains(id) && !mCache.prefetching.contains(id)) {
+        mCache.prefetching.insert(id);
+        missingIds << id;
+      }
+  }
+
+  if (missingIds.isEmpty())
+    return;
+
+  QtConcurrent::run([missingIds] {
+    for (const auto &id : missingIds) {
+      const QImage image = decode(id);
+
+      QMutexLocker locker(&mCacheMutex);
+      mCache.prefetching.remove(id);
+      if (!image.isNull()) {
+        mCache.images.insert(id, new QImage(image), ::computeCost(image));
+        ++mCache.prefetched;
+      }
+    }
+  });
+}
+
+void ThumbnailProvider::removeFromCache (const QString &id) {
+  const QString prefix = id + ":";
+
+  QMutexLocker locker(&mCacheMutex);
+  mCache.images.remove(id);
+  for (const auto &key : mCache.images.keys())
+    if (key.startsWith(prefix))
+      mCache.images.remove(key);
+}
+
+QVariantMap ThumbnailProvider::getCacheStatistics () {
+  QMutexLocker locker(&mCacheMutex);
+
+  QVariantMap statistics;
+  statistics["hits"] = mCache.hits;
+  statistics["misses"] = mCache.misses;
+  statistics["prefetched"] = mCache.prefetched;
+  statistics["count"] = mCache.images.count();
+  statistics["size"] = mCache.images.totalCost();
+  return statistics;
+}
+
+// -----------------------------------------------------------------------------
+
+QImage ThumbnailProvider::getImage (const QString &id, const QSize &requestedSize) {
+  QImage image;
+  {
+    QMutexLocker locker(&mCacheMutex);
+    if (const QImage *cachedImage = mCache.images.object(id)) {
+      image = *cachedImage;
+      ++mCache.hits;
+    } else
+      ++mCache.misses;
+  }
+
+  // 1. Natural size. (Thumbnails are small, the original is always kept.)
+  if (image.isNull()) {
+    image = decode(id);
+    if (image.isNull())
+      return image;
+
+    QMutexLocker locker(&mCacheMutex);
+    mCache.images.insert(id, new QImage(image), ::computeCost(image));
+  }
+
+  const bool scaleDown = (requestedSize.width() > 0 && requestedSize.width() < image.width()) ||
+    (requestedSize.height() > 0 && requestedSize.height() < image.height());
+  if (!scaleDown)
+    return image;
+
+  // 2. Scaled variant.
+  const QString key = QStringLiteral("%1:%2x%3").arg(id).arg(requestedSize.width()).arg(requestedSize.height());
+  {
+    QMutexLocker locker(&mCacheMutex);
+    if (const QImage *cachedImage = mCache.images.object(key))
+      return *cachedImage;
+  }
+
+  const QImage scaledImage = ::scale(image, requestedSize);
+
+  QMutexLocker locker(&mCacheMutex);
+  mCache.images.insert(key, new QImage(scaledImage), ::computeCost(scaledImage));
+  return scaledImage;
+}
+
+QImage ThumbnailProvider::decode (const QString &id) {
+  QByteArray data = ThumbnailStore::getInstance()->getData(id);
+  if (Q_UNLIKELY(data.isEmpty())) {
+    qWarning() << QStringLiteral("Unable to find thumbnail `%1`.").arg(id);
+    return QImage();
+  }
+
+  QBuffer buffer(&data);
+  QImageReader reader(&buffer, "jpg");
+  const QImage image = reader.read();
+  if (Q_UNLIKELY(image.isNull()))
+    qWarning() << QStringLiteral("Unable to read thumbnail `%1`: %2.").arg(id).arg(reader.errorString());
+  return image;
+}
@@ -23,7 +23,11 @@
 #ifndef THUMBNAIL_PROVIDER_H_
 #define THUMBNAIL_PROVIDER_H_
 
+#include <QCache>
+#include <QMutex>
 #include <QQuickImageProvider>
+#include <QSet>
+#include <QVariantMap>
 
 // =============================================================================
 
@@ -34,10 +38,34 @@ public:
 
   QImage requestImage (const QString &id, QSize *size, const QSize &requestedSize) override;
 
+  // Decodes in background the thumbnails which are not in cache.
+  static void prefetch (const QStringList &ids);
+
+  // Must be called when a thumbnail file is removed.
+  static void removeFromCache (const QString &id);
+
+  // Hits, misses and size of the decoded thumbnails cache.
+  static QVariantMap getCacheStatistics ();
+
   static const QString PROVIDER_ID;
 
 private:
-  QString mThumbnailsPath;
+  // Decoded thumbnails shared by all views. Key: `id` for the image at its
+  // natural size, `id:WxH` for a scaled variant. Cost: size in bytes.
+  struct Cache {
+    QCache<QString, QImage> images;
+    QSet<QString> prefetching;
+
+    int hits = 0;
+    int misses = 0;
+    int prefetched = 0;
+  };
+
+  static QImage getImage (const QString &id, const QSize &requestedSize);
+  static QImage decode (const QString &id);
+
+  static Cache mCache;
+  static QMutex mCacheMutex;
 };
 
 #endif // THUMBNAIL_PROVIDER_H_
@@ -0,0 +1,553 @@
+/*
+ * ThumbnailStore.cpp
+ * Copyright (C) 2026  Belledonne Communications, Grenoble, France
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *  Created on: October 17, 2026
+ */
+
+#include <cstring>
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QMutexLocker>
+#include <QSaveFile>
+
+#include "../../utils/Utils.hpp"
+#include "../paths/Paths.hpp"
+
+#include "ThumbnailStore.hpp"
+
+#define PACK_FILENAME "thumbnails.pack"
+#define INDEX_FILENAME "thumbnails.index"
+
+// Must be incremented when the pack or the index format changes.
+#define STORE_VERSION 2
+
+#define PACK_MAGIC "LTHP"
+#define RECORD_MAGIC "LTHR"
+#define INDEX_MAGIC 0x4C544849 // "LTHI"
+
+// The pack is rewritten when more than half of it is wasted. (And at least 1Mb.)
+#define COMPACTION_MIN_WASTED 1048576
+
+using namespace std;
+
+// =============================================================================
+
+namespace {
+  struct PackHeader {
+    char magic[4];
+    quint32 version;
+    quint64 id; // Written in the index too.
+  };
+
+  struct RecordHeader {
+    char magic[4];
+    quint32 removed;
+    quint32 keySize;
+    quint32 dataSize;
+  };
+}
+
+static inline qint64 computeRecordSize (int keySize, int dataSize) {
+  return qint64(sizeof(RecordHeader)) + keySize + dataSize;
+}
+
+static inline void initPackHeader (PackHeader &header, quint64 id) {
+  memcpy(header.magic, PACK_MAGIC, sizeof header.magic);
+  header.version = STORE_VERSION;
+  header.id = id;
+}
+
+// -----------------------------------------------------------------------------
+
+ThumbnailStore::ThumbnailStore (const QString &dirPath) : mDirPath(dirPath) {
+  open();
+}
+
+ThumbnailStore::~ThumbnailStore () {
+  QMutexLocker locker(&mMutex);
+  saveIndex();
+  unmap();
+}
+
+ThumbnailStore *ThumbnailStore::getInstance () {
+  static ThumbnailStore store(::Utils::coreStringToAppString(Paths::getThumbnailsDirPath()));
+  return &store;
+}
+
+// -----------------------------------------------------------------------------
+
+bool ThumbnailStore::insert (const QString &key, const QByteArray &data) {
+  QMutexLocker locker(&mMutex);
+  return append(key, data, false);
+}
+
+void ThumbnailStore::remove (const QString &key) {
+  QMutexLocker locker(&mMutex);
+  removeEntry(key);
+}
+
+QByteArray ThumbnailStore::getData (const QString &key) {
+  QMutexLocker locker(&mMutex);
+
+  auto it = mEntries.constFind(key);
+  if (it == mEntries.cend())
+    return QByteArray();
+
+  if (it->offset + it->size > mMapSize && !map())
+    return QByteArray();
+
+  if (!checkRecord(it.key(), *it)) {
+    qWarning() << QStringLiteral("Invalid thumbnail record, remove it: `%1`.").arg(key);
+    mEntries.erase(mEntries.find(key));
+    mIndexDirty = true;
+    return QByteArray();
+  }
+
+  return QByteArray(reinterpret_cast<const char *>(mMap + it->offset), it->size);
+}
+
+qint64 ThumbnailStore::getPackSize () {
+  QMutexLocker locker(&mMutex);
+  return mPack.size();
+}
+
+void ThumbnailStore::collectOrphans (const QSet<QString> &keys, qint64 packSize) {
+  QStringList orphans;
+  {
+    QMutexLocker locker(&mMutex);
+    for (auto it = mEntries.cbegin(); it != mEntries.cend(); ++it)
+      if (it->offset < packSize && !keys.contains(it.key()))
+        orphans << it.key();
+  }
+
+  // One lock per removal, the other thumbnails stay available meanwhile.
+  if (!orphans.isEmpty()) {
+    qInfo() << QStringLiteral("Remove %1 orphan thumbnails.").arg(orphans.count());
+    for (const auto &key : orphans) {
+      QMutexLocker locker(&mMutex);
+
+      // Not if it was inserted again since the snapshot.
+      auto it = mEntries.constFind(key);
+      if (it != mEntries.cend() && it->offset < packSize)
+        removeEntry(key);
+    }
+  }
+
+  compact();
+
+  QMutexLocker locker(&mMutex);
+  saveIndex();
+}
+
+QVariantMap ThumbnailStore::getStatistics () {
+  QMutexLocker locker(&mMutex);
+
+  QVariantMap statistics;
+  statistics["count"] = mEntries.count();
+  statistics["packSize"] = mPack.size();
+  statistics["wasted"] = mWasted;
+  return statistics;
+}
+
+// -----------------------------------------------------------------------------
+
+void ThumbnailStore::open () {
+  mPack.setFileName(mDirPath + PACK_FILENAME);
+  if (!mPack.open(QIODevice::ReadWrite)) {
+    qWarning() << QStringLiteral("Unable to open thumbnails pack: `%1`.").arg(mPack.fileName());
+    return;
+  }
+
+  PackHeader header;
+  if (
+    mPack.read(reinterpret_cast<char *>(&header), sizeof header) != qint64(sizeof header) ||
+    strncmp(header.magic, PACK_MAGIC, sizeof header.magic) ||
+    header.version != STORE_VERSION
+  ) {
+    if (mPack.size() > 0)
+      qWarning() << QStringLiteral("Invalid thumbnails pack, reset it: `%1`.").arg(mPack.fileName());
+
+    // A new id, so the index of a previous pack is never used.
+    ::initPackHeader(header, quint64(QDateTime::currentMSecsSinceEpoch()));
+    if (
+      !mPack.resize(0) ||
+      !mPack.seek(0) ||
+      mPack.write(reinterpret_cast<const char *>(&header), sizeof header) != qint64(sizeof header)
+    ) {
+      qWarning() << QStringLiteral("Unable to write thumbnails pack: `%1`.").arg(mPack.fileName());
+      mPack.close();
+      return;
+    }
+    mPack.flush();
+    mPackId = header.id;
+    mIndexDirty = true;
+  } else {
+    mPackId = header.id;
+    if (!loadIndex()) {
+      mEntries.clear();
+      mWasted = 0;
+      scan(sizeof(PackHeader));
+    }
+  }
+
+  migrate();
+}
+
+bool ThumbnailStore::loadIndex () {
+  QFile file(mDirPath + INDEX_FILENAME);
+  if (!file.open(QIODevice::ReadOnly))
+    return false;
+
+  QDataStream stream(&file);
+  stream.setVersion(QDataStream::Qt_5_0);
+
+  quint32 magic, version;
+  quint64 packId;
+  qint64 packSize;
+  qint32 count;
+  stream >> magic >> version >> packId >> packSize >> mWasted >> count;
+  if (
+    stream.status() != QDataStream::Ok ||
+    magic != INDEX_MAGIC || version != STORE_VERSION ||
+    packId != mPackId ||
+    packSize < qint64(sizeof(PackHeader)) || packSize > mPack.size() ||
+    count < 0
+  )
+    return false;
+
+  mEntries.reserve(count);
+  for (qint32 i = 0; i < count; ++i) {
+    QString key;
+    qint64 offset;
+    qint32 size;
+    stream >> key >> offset >> size;
+    if (stream.status() != QDataStream::Ok || offset < 0 || size < 0 || offset + size > packSize)
+      return false;
+    mEntries[key] = Entry{ offset, size };
+  }
+
+  // Records appended after the last index save. (Crash, kill...)
+  if (packSize < mPack.size())
+    scan(packSize);
+
+  return true;
+}
+
+void ThumbnailStore::saveIndex () {
+  if (!mIndexDirty || !mPack.isOpen())
+    return;
+
+  QSaveFile file(mDirPath + INDEX_FILENAME);
+  if (!file.open(QIODevice::WriteOnly)) {
+    qWarning() << QStringLiteral("Unable to write thumbnails index: `%1`.").arg(file.fileName());
+    return;
+  }
+
+  QDataStream stream(&file);
+  stream.setVersion(QDataStream::Qt_5_0);
+
+  stream << quint32(INDEX_MAGIC) << quint32(STORE_VERSION) << mPackId << mPack.size() << mWasted << qint32(mEntries.count());
+  for (auto it = mEntries.cbegin(); it != mEntries.cend(); ++it)
+    stream << it.key() << it->offset << qint32(it->size);
+
+  if (file.commit())
+    mIndexDirty = false;
+  else
+    qWarning() << QStringLiteral("Unable to write thumbnails index: `%1`.").arg(file.fileName());
+}
+
+bool ThumbnailStore::checkRecord (const QString &key, const Entry &entry) const {
+  const QByteArray keyData = key.toUtf8();
+  const qint64 offset = entry.offset - keyData.size() - qint64(sizeof(RecordHeader));
+  if (offset < qint64(sizeof(PackHeader)) || entry.offset + entry.size > mMapSize)
+    return false;
+
+  RecordHeader header;
+  memcpy(&header, mMap + offset, sizeof header);
+  return !strncmp(header.magic, RECORD_MAGIC, sizeof header.magic) &&
+    !header.removed &&
+    header.keySize == quint32(keyData.size()) &&
+    header.dataSize == quint32(entry.size) &&
+    !memcmp(mMap + offset + qint64(sizeof header), keyData.constData(), size_t(keyData.size()));
+}
+
+// -----------------------------------------------------------------------------
+
+void ThumbnailStore::scan (qint64 offset) {
+  if (!map())
+    return;
+
+  mIndexDirty = true;
+
+  while (offset < mMapSize) {
+    RecordHeader header;
+    if (offset + qint64(sizeof header) > mMapSize)
+      break;
+    memcpy(&header, mMap + offset, sizeof header);
+
+    const qint64 recordSize = ::computeRecordSize(int(header.keySize), int(header.dataSize));
+    if (
+      strncmp(header.magic, RECORD_MAGIC, sizeof header.magic) ||
+      header.keySize == 0 || header.keySize > 1024 || header.dataSize > 0x7FFFFFFF ||
+      offset + recordSize > mMapSize
+    )
+      break;
+
+    const QString key = QString::fromUtf8(
+      reinterpret_cast<const char *>(mMap + offset + qint64(sizeof header)),
+      int(header.keySize)
+    );
+
+    auto it = mEntries.find(key);
+    if (it != mEntries.end()) {
+      mWasted += ::computeRecordSize(int(header.keySize), it->size);
+      mEntries.erase(it);
+    }
+
+    if (header.removed)
+      mWasted += recordSize;
+    else
+      mEntries[key] = Entry{ offset + qint64(sizeof header) + header.keySize, int(header.dataSize) };
+
+    offset += recordSize;
+  }
+
+  // Partial record. (Crash during an append.)
+  if (offset < mMapSize) {
+    qWarning() << QStringLiteral("Truncate thumbnails pack at %1 (size: %2).").arg(offset).arg(mMapSize);
+    unmap();
+    mPack.resize(offset);
+  }
+}
+
+bool ThumbnailStore::map () {
+  if (!mPack.isOpen())
+    return false;
+
+  if (mMap && mMapSize == mPack.size())
+    return true;
+
+  unmap();
+  mMapSize = mPack.size();
+  mMap = mPack.map(0, mMapSize);
+  if (!mMap) {
+    qWarning() << QStringLiteral("Unable to map thumbnails pack: `%1`.").arg(mPack.errorString());
+    mMapSize = 0;
+    return false;
+  }
+
+  return true;
+}
+
+void ThumbnailStore::unmap () {
+  if (mMap) {
+    mPack.unmap(mMap);
+    mMap = nullptr;
+    mMapSize = 0;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+bool ThumbnailStore::append (const QString &key, const QByteArray &data, bool removed) {
+  if (!mPack.isOpen())
+    return false;
+
+  const QByteArray keyData = key.toUtf8();
+
+  RecordHeader header;
+  memcpy(header.magic, RECORD_MAGIC, sizeof header.magic);
+  header.removed = removed;
+  header.keySize = quint32(keyData.size());
+  header.dataSize = quint32(data.size());
+
+  const qint64 offset = mPack.size();
+  if (
+    !mPack.seek(offset) ||
+    mPack.write(reinterpret_cast<const char *>(&header), sizeof header) != qint64(sizeof header) ||
+    mPack.write(keyData) != keyData.size() ||
+    mPack.write(data) != data.size() ||
+    !mPack.flush()
+  ) {
+    qWarning() << QStringLiteral("Unable to write thumbnail `%1`: %2.").arg(key).arg(mPack.errorString());
+    mPack.resize(offset);
+    return false;
+  }
+
+  auto it = mEntries.find(key);
+  if (it != mEntries.end()) {
+    mWasted += ::computeRecordSize(keyData.size(), it->size);
+    mEntries.erase(it);
+  }
+
+  if (removed)
+    mWasted += ::computeRecordSize(keyData.size(), data.size());
+  else
+    mEntries[key] = Entry{ offset + qint64(sizeof header) + keyData.size(), data.size() };
+
+  mIndexDirty = true;
+  return true;
+}
+
+void ThumbnailStore::removeEntry (const QString &key) {
+  if (mEntries.contains(key))
+    append(key, QByteArray(), true);
+}
+
+void ThumbnailStore::compact () {
+  // 1. Snapshot of the entries.
+  QHash<QString, Entry> entries;
+  qint64 snapshotSize;
+  quint64 packId;
+  {
+    QMutexLocker locker(&mMutex);
+    if (!mPack.isOpen() || mWasted <= COMPACTION_MIN_WASTED || mWasted * 2 <= mPack.size())
+      return;
+
+    qInfo() << QStringLiteral("Compact thumbnails pack: %1 bytes wasted of %2.").arg(mWasted).arg(mPack.size());
+
+    entries = mEntries;
+    snapshotSize = mPack.size();
+    packId = mPackId;
+  }
+
+  // 2. Copy the snapshot records in a new pack, without lock. The pack is
+  // append-only until its replacement, so a private mapping stays valid.
+  const QString path = mDirPath + PACK_FILENAME;
+  QFile pack(path);
+  const uchar *data = pack.open(QIODevice::ReadOnly) ? pack.map(0, snapshotSize) : nullptr;
+  if (!data) {
+    qWarning() << QStringLiteral("Unable to compact thumbnails pack: `%1`.").arg(pack.errorString());
+    return;
+  }
+
+  QSaveFile file(path);
+  if (!file.open(QIODevice::WriteOnly)) {
+    qWarning() << QStringLiteral("Unable to compact thumbnails pack: `%1`.").arg(file.errorString());
+    return;
+  }
+
+  PackHeader packHeader;
+  ::initPackHeader(packHeader, packId + 1);
+  bool soFarSoGood = file.write(reinterpret_cast<const char *>(&packHeader), sizeof packHeader) == qint64(sizeof packHeader);
+
+  QHash<QString, Entry> newEntries;
+  newEntries.reserve(entries.count());
+  for (auto it = entries.cbegin(); soFarSoGood && it != entries.cend(); ++it) {
+    const QByteArray keyData = it.key().toUtf8();
+
+    RecordHeader header;
+    memcpy(header.magic, RECORD_MAGIC, sizeof header.magic);
+    header.removed = 0;
+    header.keySize = quint32(keyData.size());
+    header.dataSize = quint32(it->size);
+
+    const qint64 offset = file.pos();
+    soFarSoGood = file.write(reinterpret_cast<const char *>(&header), sizeof header) == qint64(sizeof header) &&
+      file.write(keyData) == keyData.size() &&
+      file.write(reinterpret_cast<const char *>(data + it->offset), it->size) == it->size;
+
+    newEntries[it.key()] = Entry{ offset + qint64(sizeof header) + keyData.size(), it->size };
+  }
+
+  pack.unmap(const_cast<uchar *>(data));
+  pack.close();
+
+  // 3. Copy the records appended since the snapshot, then swap the packs.
+  QMutexLocker locker(&mMutex);
+  if (!soFarSoGood || !mPack.isOpen() || mPackId != packId || !map()) {
+    qWarning() << QStringLiteral("Unable to compact thumbnails pack: `%1`.").arg(file.errorString());
+    file.cancelWriting();
+    return;
+  }
+
+  const qint64 tailOffset = file.pos();
+  const qint64 tailSize = mPack.size() - snapshotSize;
+  if (
+    tailSize > 0 &&
+    file.write(reinterpret_cast<const char *>(mMap + snapshotSize), tailSize) != tailSize
+  ) {
+    qWarning() << QStringLiteral("Unable to compact thumbnails pack: `%1`.").arg(file.errorString());
+    file.cancelWriting();
+    return;
+  }
+
+  // The pack must be closed before the replacement. (Windows.)
+  unmap();
+  mPack.close();
+
+  const bool committed = file.commit();
+  if (!committed)
+    qWarning() << QStringLiteral("Unable to compact thumbnails pack: `%1`.").arg(file.errorString());
+
+  if (!mPack.open(QIODevice::ReadWrite)) {
+    qWarning() << QStringLiteral("Unable to open thumbnails pack: `%1`.").arg(mPack.fileName());
+    mEntries.clear();
+    return;
+  }
+
+  if (!committed)
+    return;
+
+  // Entries of the snapshot are moved, the newer ones are shifted with the tail.
+  QHash<QString, Entry> rebasedEntries;
+  rebasedEntries.reserve(mEntries.count());
+  qint64 used = qint64(sizeof(PackHeader));
+  for (auto it = mEntries.cbegin(); it != mEntries.cend(); ++it) {
+    Entry entry = *it;
+    if (entry.offset >= snapshotSize)
+      entry.offset += tailOffset - snapshotSize;
+    else
+      entry = newEntries.value(it.key());
+
+    rebasedEntries[it.key()] = entry;
+    used += ::computeRecordSize(it.key().toUtf8().size(), entry.size);
+  }
+
+  mEntries = rebasedEntries;
+  mWasted = mPack.size() - used;
+  mPackId = packId + 1;
+  mIndexDirty = true;
+  saveIndex();
+}
+
+// -----------------------------------------------------------------------------
+
+void ThumbnailStore::migrate () {
+  QDir dir(mDirPath);
+  const QStringList fileNames = dir.entryList({ "*.jpg" }, QDir::Files);
+  if (fileNames.isEmpty())
+    return;
+
+  qInfo() << QStringLiteral("Migrate %1 thumbnails files in pack.").arg(fileNames.count());
+
+  for (const auto &fileName : fileNames) {
+    QFile file(dir.filePath(fileName));
+    if (!file.open(QIODevice::ReadOnly))
+      continue;
+
+    if (mEntries.contains(fileName) || append(fileName, file.readAll(), false)) {
+      file.close();
+      file.remove();
+    }
+  }
+
+  saveIndex();
+}
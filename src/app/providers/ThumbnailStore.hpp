@@ -0,0 +1,103 @@
+/*
+ * ThumbnailStore.hpp
+ * Copyright (C) 2026  Belledonne Communications, Grenoble, France
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *  Created on: October 17, 2026
+ */
+
+#ifndef THUMBNAIL_STORE_H_
+#define THUMBNAIL_STORE_H_
+
+#include <QFile>
+#include <QHash>
+#include <QMutex>
+#include <QSet>
+#include <QVariantMap>
+
+// =============================================================================
+
+// Thumbnails packed in one append-only file, mapped in memory.
+// Keys are the file ids stored in the messages app data.
+// A removal appends a tombstone, the space is reclaimed by `compact`.
+// An index file avoids a full scan of the pack at startup. It is bound to
+// one pack by its id, which changes at each compaction.
+class ThumbnailStore {
+public:
+  ~ThumbnailStore ();
+
+  bool insert (const QString &key, const QByteArray &data);
+  void remove (const QString &key);
+
+  // Returns a copy of the thumbnail data, or an empty array.
+  QByteArray getData (const QString &key);
+
+  // Pack size, used to protect the thumbnails added after a keys snapshot.
+  qint64 getPackSize ();
+
+  // Removes the thumbnails written before `packSize` which are not in `keys`,
+  // then compacts the pack if too much space is wasted. Thread-safe, can be
+  // long: must be called in background.
+  void collectOrphans (const QSet<QString> &keys, qint64 packSize);
+
+  // Count, pack size and wasted bytes.
+  QVariantMap getStatistics ();
+
+  static ThumbnailStore *getInstance ();
+
+private:
+  struct Entry {
+    qint64 offset; // Data offset in the pack.
+    int size;
+  };
+
+  ThumbnailStore (const QString &dirPath);
+
+  void open ();
+  bool loadIndex ();
+  void saveIndex ();
+
+  // Checks the record header of an entry. (Key and sizes.)
+  bool checkRecord (const QString &key, const Entry &entry) const;
+
+  void scan (qint64 offset);
+  bool map ();
+  void unmap ();
+
+  bool append (const QString &key, const QByteArray &data, bool removed);
+  void removeEntry (const QString &key);
+
+  // Rewrites the pack without lock, then swaps it under lock.
+  // Must be called without the lock.
+  void compact ();
+
+  // Imports the thumbnails of the previous layout: one jpeg file per thumbnail.
+  void migrate ();
+
+  QString mDirPath;
+  QFile mPack;
+  quint64 mPackId = 0;
+  uchar *mMap = nullptr;
+  qint64 mMapSize = 0;
+
+  QHash<QString, Entry> mEntries;
+  qint64 mWasted = 0;
+  bool mIndexDirty = false;
+
+  QMutex mMutex;
+};
+
+#endif // THUMBNAIL_STORE_H_
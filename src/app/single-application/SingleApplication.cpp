@@ -21,14 +21,19 @@
 // THE SOFTWARE.
 
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 
 #include <QtCore/QDir>
 #include <QtCore/QProcess>
 #include <QtCore/QByteArray>
+#include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QEventLoop>
 #include <QtCore/QSemaphore>
 #include <QtCore/QSharedMemory>
 #include <QtCore/QStandardPaths>
+#include <QtCore/QTimer>
 #include <QtCore/QCryptographicHash>
 #include <QtNetwork/QLocalServer>
 #include <QtNetwork/QLocalSocket>
@@ -53,8 +58,22 @@
 static const char NewInstance = 'N';
 static const char SecondaryInstance = 'S';
 static const char Reconnect = 'R';
+static const char Channel = 'C';
 static const char InvalidConnection = '\0';
 
+// A channel sending a longer request without line feed is closed.
+static const int MaxRequestSize = 65536;
+
+// A new connection must send its init message in this delay.
+static const int HandshakeTimeout = 1000;
+
+// Used by the secondary instances when no timeout is given: a hung primary
+// must not block them forever.
+static const int DefaultTimeout = 5000;
+
+// Same thing for the replies of the requests, a command can take longer.
+static const int DefaultRequestTimeout = 30000;
+
 using namespace std;
 
 // -----------------------------------------------------------------------------
@@ -128,6 +147,9 @@ void SingleApplicationPrivate::genBlockServerName (int timeout) {
     #endif // ifdef Q_OS_UNIX
   }
 
+  if (!instanceKey.isEmpty())
+    appData.addData(instanceKey);
+
   // Replace the backslash in RFC 2045 Base64 [a-zA-Z0-9+/=] to comply with
   // server naming requirements.
   blockServerName = appData.result().toBase64().replace("/", "_");
@@ -184,16 +206,65 @@ void SingleApplicationPrivate::startSecondary () {
   #endif // ifdef Q_OS_UNIX
 }
 
-void SingleApplicationPrivate::connectToPrimary (int msecs, char connectionType) {
+// Processes the events until `socket` emits `signal`, an error occurs or
+// `msecs` elapse. (No limit if `msecs` is negative.)
+template<typename Signal>
+static void waitForSignal (QLocalSocket *socket, Signal signal, int msecs) {
+  QEventLoop loop;
+  QObject::connect(socket, signal, &loop, &QEventLoop::quit);
+  QObject::connect(socket, &QLocalSocket::disconnected, &loop, &QEventLoop::quit);
+  QObject::connect(
+    socket, QOverload<QLocalSocket::LocalSocketError>::of(&QLocalSocket::error),
+    &loop, &QEventLoop::quit
+  );
+
+  QTimer timer;
+  if (msecs >= 0) {
+    timer.setSingleShot(true);
+    QObject::connect(&timer, &QTimer::timeout, &loop, &QEventLoop::quit);
+    timer.start(msecs);
+  }
+
+  loop.exec(QEventLoop::ExcludeUserInputEvents);
+}
+
+static int getRemainingTime (const QElapsedTimer &timer, int msecs) {
+  return msecs < 0 ? -1 : qMax(0, msecs - int(timer.elapsed()));
+}
+
+// Returns true if all data was written before the deadline.
+static bool waitForBytesWritten (QLocalSocket *socket, const QElapsedTimer &timer, int msecs) {
+  socket->flush();
+  while (socket->bytesToWrite() > 0 && socket->state() == QLocalSocket::ConnectedState) {
+    const int remainingTime = ::getRemainingTime(timer, msecs);
+    if (!remainingTime)
+      return false;
+    ::waitForSignal(socket, &QLocalSocket::bytesWritten, remainingTime);
+  }
+
+  return socket->bytesToWrite() == 0;
+}
+
+bool SingleApplicationPrivate::connectToPrimary (int msecs, char connectionType) {
+  if (msecs < 0)
+    msecs = DefaultTimeout;
+
+  QElapsedTimer timer;
+  timer.start();
+
   // Connect to the Local Server of the Primary Instance if not already
   // connected.
   if (socket == nullptr) {
     socket = new QLocalSocket();
   }
 
-  // If already connected - we are done;
-  if (socket->state() == QLocalSocket::ConnectedState)
-    return;
+  // If already connected with the same type - we are done. (The connection
+  // is reused.) Otherwise the primary would read it with the other protocol.
+  if (socket->state() == QLocalSocket::ConnectedState) {
+    if (socketConnectionType == connectionType)
+      return true;
+    socket->abort();
+  }
 
   // If not connect
   if (socket->state() == QLocalSocket::UnconnectedState ||
@@ -203,22 +274,32 @@ void SingleApplicationPrivate::connectToPrimary (int msecs, char connectionType)
 
   // Wait for being connected
   if (socket->state() == QLocalSocket::ConnectingState) {
-    socket->waitForConnected(msecs);
+    ::waitForSignal(socket, &QLocalSocket::connected, msecs);
+  }
+
+  if (socket->state() != QLocalSocket::ConnectedState) {
+    qWarning() << QStringLiteral("Unable to connect to the primary instance: `%1`.").arg(socket->errorString());
+    socket->abort();
+    return false;
   }
 
   // Initialisation message according to the SingleApplication protocol
-  if (socket->state() == QLocalSocket::ConnectedState) {
-    // Notify the parent that a new instance had been started;
-    QByteArray initMsg = blockServerName.toLatin1();
+  // Notify the parent that a new instance had been started;
+  QByteArray initMsg = blockServerName.toLatin1();
 
-    initMsg.append(connectionType);
-    initMsg.append(reinterpret_cast<const char *>(&instanceNumber), sizeof(quint32));
-    initMsg.append(QByteArray::number(qChecksum(initMsg.constData(), static_cast<uint>(initMsg.length())), 256));
+  initMsg.append(connectionType);
+  initMsg.append(reinterpret_cast<const char *>(&instanceNumber), sizeof(quint32));
+  initMsg.append(QByteArray::number(qChecksum(initMsg.constData(), static_cast<uint>(initMsg.length())), 256));
 
-    socket->write(initMsg);
-    socket->flush();
-    socket->waitForBytesWritten(msecs);
+  socket->write(initMsg);
+  if (::waitForBytesWritten(socket, timer, msecs)) {
+    socketConnectionType = connectionType;
+    return true;
   }
+
+  qWarning() << QStringLiteral("The primary instance does not respond.");
+  socket->abort();
+  return false;
 }
 
 #ifdef Q_OS_UNIX
@@ -270,50 +351,108 @@ void SingleApplicationPrivate::connectToPrimary (int msecs, char connectionType)
 
 /**
  * @brief Executed when a connection has been made to the LocalServer
+ * @note The init message is read asynchronously: the connection is closed if
+ * it is not received before HandshakeTimeout.
  */
 void SingleApplicationPrivate::slotConnectionEstablished () {
-  Q_Q(SingleApplication);
+  while (QLocalSocket *nextConnSocket = server->nextPendingConnection()) {
+    QTimer *timer = new QTimer(nextConnSocket);
+    timer->setSingleShot(true);
+    QObject::connect(timer, &QTimer::timeout, this, [nextConnSocket, this]() {
+        qWarning() << QStringLiteral("No init message received from new connection.");
+        rejectConnection(nextConnSocket);
+      });
+    timer->start(HandshakeTimeout);
+    pendingConnections[nextConnSocket] = timer;
+
+    QObject::connect(nextConnSocket, &QLocalSocket::readyRead, this, [nextConnSocket, this]() {
+        slotHandshakeDataAvailable(nextConnSocket);
+      });
+    QObject::connect(nextConnSocket, &QLocalSocket::disconnected, this, [nextConnSocket, this]() {
+        rejectConnection(nextConnSocket);
+      });
+
+    if (nextConnSocket->bytesAvailable() > 0)
+      slotHandshakeDataAvailable(nextConnSocket);
+  }
+}
 
-  QLocalSocket *nextConnSocket = server->nextPendingConnection();
+void SingleApplicationPrivate::slotHandshakeDataAvailable (QLocalSocket *nextConnSocket) {
+  if (!pendingConnections.contains(nextConnSocket))
+    return;
 
   // Verify that the new connection follows the SingleApplication protocol
-  char connectionType = InvalidConnection;
-  quint32 instanceId;
-  QByteArray initMsg, tmp;
-  if (nextConnSocket->waitForReadyRead(100)) {
-    tmp = nextConnSocket->read(blockServerName.length());
+  const QByteArray serverName = blockServerName.toLatin1();
+  const int headerSize = serverName.length() + 1 + int(sizeof(quint32));
+
+  const qint64 available = nextConnSocket->bytesAvailable();
+  if (available < headerSize) {
     // Verify that the socket data start with blockServerName
-    if (tmp == blockServerName.toLatin1()) {
-      initMsg = tmp;
-      connectionType = nextConnSocket->read(1)[0];
-
-      switch (connectionType) {
-        case NewInstance:
-        case SecondaryInstance:
-        case Reconnect: {
-          initMsg += connectionType;
-          tmp = nextConnSocket->read(sizeof(quint32));
-          const char *data = tmp.constData();
-          instanceId = static_cast<quint32>(*data);
-          initMsg += tmp;
-          // Verify the checksum of the initMsg
-          QByteArray checksum = QByteArray::number(
-              qChecksum(initMsg.constData(), static_cast<uint>(initMsg.length())),
-              256
-            );
-          tmp = nextConnSocket->read(checksum.length());
-          if (checksum == tmp)
-            break; // Otherwise set to invalid connection (next line)
-        } UTILS_NO_BREAK;
-        default:
-          connectionType = InvalidConnection;
-      }
-    }
+    if (!serverName.startsWith(nextConnSocket->peek(qMin(available, qint64(serverName.length())))))
+      rejectConnection(nextConnSocket);
+    return;
+  }
+
+  const QByteArray initMsg = nextConnSocket->peek(headerSize);
+  const char connectionType = initMsg[serverName.length()];
+  if (!initMsg.startsWith(serverName) || (
+    connectionType != NewInstance &&
+    connectionType != SecondaryInstance &&
+    connectionType != Reconnect &&
+    connectionType != Channel
+  )) {
+    rejectConnection(nextConnSocket);
+    return;
   }
 
-  if (connectionType == InvalidConnection) {
-    nextConnSocket->close();
-    delete nextConnSocket;
+  // Verify the checksum of the initMsg
+  const QByteArray checksum = QByteArray::number(
+      qChecksum(initMsg.constData(), static_cast<uint>(initMsg.length())),
+      256
+    );
+  if (available < headerSize + checksum.length())
+    return;
+
+  nextConnSocket->read(headerSize);
+  if (nextConnSocket->read(checksum.length()) != checksum) {
+    rejectConnection(nextConnSocket);
+    return;
+  }
+
+  quint32 instanceId;
+  memcpy(&instanceId, initMsg.constData() + serverName.length() + 1, sizeof(quint32));
+
+  // Handshake done.
+  delete pendingConnections.take(nextConnSocket);
+  QObject::disconnect(nextConnSocket, nullptr, this, nullptr);
+
+  acceptConnection(nextConnSocket, connectionType, instanceId);
+}
+
+void SingleApplicationPrivate::rejectConnection (QLocalSocket *nextConnSocket) {
+  if (!pendingConnections.remove(nextConnSocket))
+    return;
+
+  QObject::disconnect(nextConnSocket, nullptr, this, nullptr);
+  nextConnSocket->abort();
+  nextConnSocket->deleteLater();
+}
+
+void SingleApplicationPrivate::acceptConnection (QLocalSocket *nextConnSocket, char connectionType, quint32 instanceId) {
+  Q_Q(SingleApplication);
+
+  if (connectionType == Channel) {
+    channelBuffers[nextConnSocket];
+
+    QObject::connect(nextConnSocket, &QLocalSocket::disconnected, this, [nextConnSocket, this]() {
+        slotChannelClosed(nextConnSocket);
+      });
+    QObject::connect(nextConnSocket, &QLocalSocket::readyRead, this, [nextConnSocket, this]() {
+        slotRequestsAvailable(nextConnSocket);
+      });
+
+    if (nextConnSocket->bytesAvailable() > 0)
+      slotRequestsAvailable(nextConnSocket);
     return;
   }
 
@@ -343,6 +482,56 @@ void SingleApplicationPrivate::slotDataAvailable (QLocalSocket *dataSocket, quin
   Q_EMIT q->receivedMessage(instanceId, dataSocket->readAll());
 }
 
+void SingleApplicationPrivate::slotRequestsAvailable (QLocalSocket *channelSocket) {
+  Q_Q(SingleApplication);
+
+  auto it = channelBuffers.find(channelSocket);
+  if (it == channelBuffers.end())
+    return;
+
+  it->append(channelSocket->readAll());
+
+  // Requests are separated by line feeds. Keep the last partial one.
+  int begin = 0;
+  int end;
+  while ((end = it->indexOf('\n', begin)) != -1) {
+    QByteArray request = it->mid(begin, end - begin);
+    begin = end + 1;
+
+    if (request.endsWith('\r'))
+      request.chop(1);
+
+    const quint64 requestId = nextRequestId++;
+    pendingRequests[requestId] = channelSocket;
+    Q_EMIT q->receivedRequest(requestId, request);
+
+    // The channel can be closed by a receiver.
+    it = channelBuffers.find(channelSocket);
+    if (it == channelBuffers.end())
+      return;
+  }
+  it->remove(0, begin);
+
+  if (it->size() > MaxRequestSize) {
+    qWarning() << QStringLiteral("Request too long, closing channel.");
+    channelSocket->abort();
+    slotChannelClosed(channelSocket);
+  }
+}
+
+void SingleApplicationPrivate::slotChannelClosed (QLocalSocket *closedSocket) {
+  if (!channelBuffers.remove(closedSocket))
+    return;
+
+  for (auto it = pendingRequests.begin(); it != pendingRequests.end(); ) {
+    if (it.value() == closedSocket)
+      it = pendingRequests.erase(it);
+    else
+      ++it;
+  }
+  closedSocket->deleteLater();
+}
+
 void SingleApplicationPrivate::slotClientConnectionClosed (QLocalSocket *closedSocket, quint32 instanceId) {
   if (closedSocket->bytesAvailable() > 0)
     Q_EMIT slotDataAvailable(closedSocket, instanceId);
@@ -356,12 +545,19 @@ void SingleApplicationPrivate::slotClientConnectionClosed (QLocalSocket *closedS
  * @param argv
  * @param {bool} allowSecondaryInstances
  */
-SingleApplication::SingleApplication (int &argc, char *argv[], bool allowSecondary, Options options, int timeout)
-  : QApplication(argc, argv), d_ptr(new SingleApplicationPrivate(this)) {
+SingleApplication::SingleApplication (
+  int &argc,
+  char *argv[],
+  bool allowSecondary,
+  Options options,
+  int timeout,
+  const QByteArray &instanceKey
+) : QApplication(argc, argv), d_ptr(new SingleApplicationPrivate(this)) {
   Q_D(SingleApplication);
 
   // Store the current mode of the program
   d->options = options;
+  d->instanceKey = instanceKey;
 
   // Generating an application ID used for identifying the shared memory
   // block and QLocalServer
@@ -445,13 +641,65 @@ bool SingleApplication::sendMessage (QByteArray message, int timeout) {
 
   // Nobody to connect to
   if (isPrimary()) return false;
+
+  if (timeout < 0)
+    timeout = DefaultTimeout;
+
+  QElapsedTimer timer;
+  timer.start();
+
   // Make sure the socket is connected
+  if (!d->connectToPrimary(timeout, Reconnect))
+    return false;
 
-  d->connectToPrimary(timeout, Reconnect);
   d->socket->write(message);
-  bool dataWritten = d->socket->flush();
-  d->socket->waitForBytesWritten(timeout);
-  return dataWritten;
+  return ::waitForBytesWritten(d->socket, timer, timeout);
+}
+
+bool SingleApplication::openChannel (int timeout) {
+  Q_D(SingleApplication);
+
+  if (isPrimary()) return false;
+
+  return d->connectToPrimary(timeout, Channel);
+}
+
+bool SingleApplication::sendRequest (const QByteArray &request, QByteArray &reply, int timeout) {
+  Q_D(SingleApplication);
+
+  if (!d->socket || d->socket->state() != QLocalSocket::ConnectedState || d->socketConnectionType != Channel)
+    return false;
+
+  if (timeout < 0)
+    timeout = DefaultRequestTimeout;
+
+  QElapsedTimer timer;
+  timer.start();
+
+  d->socket->write(request + '\n');
+  if (!::waitForBytesWritten(d->socket, timer, timeout))
+    return false;
+
+  while (!d->socket->canReadLine()) {
+    const int remainingTime = ::getRemainingTime(timer, timeout);
+    if (!remainingTime || d->socket->state() != QLocalSocket::ConnectedState)
+      return false;
+    ::waitForSignal(d->socket, &QLocalSocket::readyRead, remainingTime);
+  }
+
+  reply = d->socket->readLine();
+  reply.chop(1);
+  return true;
+}
+
+void SingleApplication::sendReply (quint64 requestId, const QByteArray &reply) {
+  Q_D(SingleApplication);
+
+  QLocalSocket *socket = d->pendingRequests.take(requestId);
+  if (socket) {
+    socket->write(reply + '\n');
+    socket->flush();
+  }
 }
 
 void SingleApplication::quit () {
@@ -72,6 +72,8 @@ public:
    * @arg {Mode} mode - Whether for the SingleApplication block to be applied
    * User wide or System wide.
    * @arg {int} timeout - Timeout to wait in miliseconds.
+   * @arg {QByteArray} instanceKey - Separates the instances of the same
+   * application, e.g. one per profile. Empty: one instance per user or system.
    * @note argc and argv may be changed as Qt removes arguments that it
    * recognizes
    * @note Mode::SecondaryNotification only works if set on both the primary
@@ -82,7 +84,14 @@ public:
    * Usually 4*timeout would be the worst case (fail) scenario.
    * @see See the corresponding QAPPLICATION_CLASS constructor for reference
    */
-  explicit SingleApplication (int &argc, char *argv[], bool allowSecondary = false, Options options = Mode::User, int timeout = 100);
+  explicit SingleApplication (
+    int &argc,
+    char *argv[],
+    bool allowSecondary = false,
+    Options options = Mode::User,
+    int timeout = 100,
+    const QByteArray &instanceKey = QByteArray()
+  );
   virtual ~SingleApplication ();
 
   /**
@@ -105,18 +114,49 @@ public:
 
   /**
    * @brief Sends a message to the primary instance. Returns true on success.
-   * @param {int} timeout - Timeout for connecting
+   * @param {int} timeout - Timeout for connecting and writing, -1 for the
+   * default timeout (5 seconds)
    * @returns {bool}
    * @note sendMessage() will return false if invoked from the primary
    * instance.
    */
   bool sendMessage (QByteArray message, int timeout = 100);
 
+  /**
+   * @brief Opens a persistent channel to the primary instance. Returns true
+   * on success.
+   * @param {int} timeout - Timeout for connecting
+   * @returns {bool}
+   * @note Requests are then sent with sendRequest(), each one is received by
+   * the primary instance via receivedRequest().
+   */
+  bool openChannel (int timeout = 100);
+
+  /**
+   * @brief Sends a request on the channel and waits for its reply. Returns
+   * false if the channel is closed or on timeout.
+   * @param {QByteArray} request - Request, without line feed
+   * @param {QByteArray &} reply - Reply of the primary instance
+   * @param {int} timeout - Timeout for the reply, -1 for the default
+   * timeout (30 seconds)
+   * @returns {bool}
+   */
+  bool sendRequest (const QByteArray &request, QByteArray &reply, int timeout = -1);
+
+  /**
+   * @brief Replies to a request received via receivedRequest(). Can be
+   * called later, a reply to a closed channel is dropped.
+   * @param {quint64} requestId - Id given by receivedRequest()
+   * @param {QByteArray} reply - Reply, without line feed
+   */
+  void sendReply (quint64 requestId, const QByteArray &reply);
+
   virtual void quit ();
 
 Q_SIGNALS:
   void instanceStarted ();
   void receivedMessage (quint32 instanceId, QByteArray message);
+  void receivedRequest (quint64 requestId, QByteArray request);
 
 private:
   SingleApplicationPrivate *d_ptr;
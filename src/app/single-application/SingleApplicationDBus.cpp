@@ -24,6 +24,7 @@
 #include <iostream>
 
 #include <QtCore/QByteArray>
+#include <QtCore/QCryptographicHash>
 #include <QtDBus/QtDBus>
 
 #include "SingleApplication.hpp"
@@ -33,6 +34,12 @@
 
 const char *SERVICE_NAME = "org.linphone.SingleApplication";
 
+// Used when no timeout is given: a hung primary must not block forever.
+const int DEFAULT_TIMEOUT = 5000;
+
+// Same thing for the replies of the requests, a command can take longer.
+const int DEFAULT_REQUEST_TIMEOUT = 30000;
+
 SingleApplicationPrivate::SingleApplicationPrivate (SingleApplication *q_ptr)
   : QDBusAbstractAdaptor(q_ptr), q_ptr(q_ptr) {}
 
@@ -53,20 +60,33 @@ void SingleApplicationPrivate::startSecondary () {
   instanceNumber = 1;
 }
 
-SingleApplication::SingleApplication (int &argc, char *argv[], bool allowSecondary, Options options, int)
-  : QApplication(argc, argv), d_ptr(new SingleApplicationPrivate(this)) {
+SingleApplication::SingleApplication (
+  int &argc,
+  char *argv[],
+  bool allowSecondary,
+  Options options,
+  int,
+  const QByteArray &instanceKey
+) : QApplication(argc, argv), d_ptr(new SingleApplicationPrivate(this)) {
   Q_D(SingleApplication);
 
   // Store the current mode of the program
   d->options = options;
 
+  // One service per instance key. (A name element cannot start with a digit.)
+  d->serviceName = SERVICE_NAME;
+  if (!instanceKey.isEmpty())
+    d->serviceName += QStringLiteral(".i") + QString::fromLatin1(
+      QCryptographicHash::hash(instanceKey, QCryptographicHash::Sha1).toHex()
+    );
+
   if (!d->getBus().isConnected()) {
     qWarning() << QStringLiteral("Cannot connect to the D-Bus session bus.");
     delete d;
     ::exit(EXIT_FAILURE);
   }
 
-  if (d->getBus().registerService(SERVICE_NAME)) {
+  if (d->getBus().registerService(d->serviceName)) {
     d->startPrimary();
     return;
   }
@@ -105,14 +125,47 @@ bool SingleApplication::sendMessage (QByteArray message, int timeout) {
 
   if (isPrimary()) return false;
 
-  QDBusInterface iface(SERVICE_NAME, "/", "", d->getBus());
-  if (iface.isValid()) {
-    iface.setTimeout(timeout);
-    QDBusMessage msg = iface.call(QDBus::Block, "messageReceived", instanceId(), message);
-    return true;
-  }
+  // No introspection, events are processed while waiting: a hung primary
+  // cannot block longer than the timeout.
+  QDBusMessage call = QDBusMessage::createMethodCall(d->serviceName, "/", "", "messageReceived");
+  call << instanceId() << message;
+  return d->getBus().call(
+    call, QDBus::BlockWithGui, timeout < 0 ? DEFAULT_TIMEOUT : timeout
+  ).type() == QDBusMessage::ReplyMessage;
+}
+
+bool SingleApplication::openChannel (int timeout) {
+  Q_D(SingleApplication);
 
-  return false;
+  if (isPrimary()) return false;
+
+  // No persistent connection on D-Bus, only check that the primary is reachable.
+  Q_UNUSED(timeout);
+  return d->getBus().interface()->isServiceRegistered(d->serviceName);
+}
+
+bool SingleApplication::sendRequest (const QByteArray &request, QByteArray &reply, int timeout) {
+  Q_D(SingleApplication);
+
+  QDBusMessage call = QDBusMessage::createMethodCall(d->serviceName, "/", "", "requestReceived");
+  call << request;
+  QDBusMessage msg = d->getBus().call(call, QDBus::BlockWithGui, timeout < 0 ? DEFAULT_REQUEST_TIMEOUT : timeout);
+  if (msg.type() != QDBusMessage::ReplyMessage || msg.arguments().isEmpty())
+    return false;
+
+  reply = msg.arguments().first().toByteArray();
+  return true;
+}
+
+void SingleApplication::sendReply (quint64 requestId, const QByteArray &reply) {
+  Q_D(SingleApplication);
+
+  auto it = d->pendingRequests.find(requestId);
+  if (it == d->pendingRequests.end())
+    return;
+
+  d->getBus().send(it->createReply(QVariant(reply)));
+  d->pendingRequests.erase(it);
 }
 
 void SingleApplicationPrivate::messageReceived (quint32 instanceId, QByteArray message) {
@@ -120,6 +173,17 @@ void SingleApplicationPrivate::messageReceived (quint32 instanceId, QByteArray m
   Q_EMIT q->receivedMessage(instanceId, message);
 }
 
+QByteArray SingleApplicationPrivate::requestReceived (QByteArray request, const QDBusMessage &message) {
+  Q_Q(SingleApplication);
+
+  const quint64 requestId = nextRequestId++;
+  message.setDelayedReply(true);
+  pendingRequests[requestId] = message;
+  Q_EMIT q->receivedRequest(requestId, request);
+
+  return QByteArray();
+}
+
 void SingleApplication::quit () {
   QCoreApplication::quit();
 }
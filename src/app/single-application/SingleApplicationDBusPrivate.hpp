@@ -49,10 +49,16 @@ public:
 
   SingleApplication *q_ptr;
   SingleApplication::Options options;
+  QString serviceName;
   quint32 instanceNumber;
 
+  // Requests waiting a reply. (Delayed D-Bus replies.)
+  QHash<quint64, QDBusMessage> pendingRequests;
+  quint64 nextRequestId = 0;
+
 public Q_SLOTS:
   void messageReceived (quint32 instanceId, QByteArray message);
+  QByteArray requestReceived (QByteArray request, const QDBusMessage &message);
 };
 
 #endif // SINGLE_APPLICATION_DBUS_PRIVATE_H_
@@ -32,8 +32,11 @@
 #ifndef SINGLE_APPLICATION_PRIVATE_H_
 #define SINGLE_APPLICATION_PRIVATE_H_
 
+#include <QtCore/QHash>
 #include <QtCore/QMutex>
+#include <QtCore/QPointer>
 #include <QtCore/QSharedMemory>
+#include <QtCore/QTimer>
 #include <QtNetwork/QLocalServer>
 #include <QtNetwork/QLocalSocket>
 
@@ -56,7 +59,10 @@ public:
   void genBlockServerName (int msecs);
   void startPrimary (bool resetMemory);
   void startSecondary ();
-  void connectToPrimary (int msecs, char connectionType);
+  bool connectToPrimary (int msecs, char connectionType);
+
+  void rejectConnection (QLocalSocket *nextConnSocket);
+  void acceptConnection (QLocalSocket *nextConnSocket, char connectionType, quint32 instanceId);
 
   #ifdef Q_OS_UNIX
     void crashHandler ();
@@ -68,15 +74,28 @@ public:
   QSharedMemory *memory;
   SingleApplication *q_ptr;
   QLocalSocket *socket;
+  char socketConnectionType = 0;
   QLocalServer *server;
   quint32 instanceNumber;
   QString blockServerName;
+  QByteArray instanceKey;
   SingleApplication::Options options;
 
+  // Connections waiting for their init message, with their handshake timer.
+  QHash<QLocalSocket *, QTimer *> pendingConnections;
+
+  // Channels: partial request of each socket and requests waiting a reply.
+  QHash<QLocalSocket *, QByteArray> channelBuffers;
+  QHash<quint64, QPointer<QLocalSocket>> pendingRequests;
+  quint64 nextRequestId = 0;
+
 public Q_SLOTS:
   void slotConnectionEstablished ();
+  void slotHandshakeDataAvailable(QLocalSocket *);
   void slotDataAvailable(QLocalSocket *, quint32);
+  void slotRequestsAvailable(QLocalSocket *);
   void slotClientConnectionClosed(QLocalSocket *, quint32);
+  void slotChannelClosed(QLocalSocket *);
 };
 
 #endif // SINGLE_APPLICATION_PRIVATE_H_
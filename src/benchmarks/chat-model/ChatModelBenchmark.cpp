@@ -0,0 +1,52 @@
+/*
+ * ChatModelBenchmark.cpp
+ * Copyright (C) 2026  Belledonne Communications, Grenoble, France
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *  Created on: October 17, 2026
+ */
+
+#include <QTest>
+
+#include "../../components/chat/ChatModel.hpp"
+#include "../../components/core/CoreManager.hpp"
+#include "../../utils/Utils.hpp"
+
+#include "ChatModelBenchmark.hpp"
+
+using namespace std;
+
+// =============================================================================
+
+// Opens the biggest conversation of the profile: history and calls are loaded.
+void ChatModelBenchmark::benchmarkSetSipAddress () {
+  shared_ptr<linphone::ChatRoom> biggestChatRoom;
+  for (const auto &chatRoom : CoreManager::getInstance()->getCore()->getChatRooms())
+    if (!biggestChatRoom || chatRoom->getHistorySize() > biggestChatRoom->getHistorySize())
+      biggestChatRoom = chatRoom;
+
+  if (!biggestChatRoom || !biggestChatRoom->getHistorySize())
+    QSKIP("No chat history in this profile.");
+
+  const QString sipAddress = ::Utils::coreStringToAppString(
+    biggestChatRoom->getPeerAddress()->asStringUriOnly()
+  );
+  qInfo() << QStringLiteral("Open conversation of %1 messages.").arg(biggestChatRoom->getHistorySize());
+
+  QBENCHMARK {
+    ChatModel chatModel(sipAddress);
+  }
+}
@@ -0,0 +1,52 @@
+/*
+ * ContactsListBenchmark.cpp
+ * Copyright (C) 2026  Belledonne Communications, Grenoble, France
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *  Created on: October 17, 2026
+ */
+
+#include <QTest>
+
+#include "../../components/contacts/ContactsListModel.hpp"
+#include "../../components/contacts/ContactsListProxyModel.hpp"
+#include "../../components/core/CoreManager.hpp"
+
+#include "ContactsListBenchmark.hpp"
+
+// =============================================================================
+
+void ContactsListBenchmark::benchmarkFilter_data () {
+  QTest::addColumn<QString>("pattern");
+
+  QTest::newRow("no filter") << "";
+  QTest::newRow("one letter") << "a";
+  QTest::newRow("name") << "john";
+  QTest::newRow("two words") << "john doe";
+  QTest::newRow("sip address") << "sip:john";
+}
+
+// Each contact is weighted with the filter, then the contacts are sorted by weight.
+void ContactsListBenchmark::benchmarkFilter () {
+  ContactsListProxyModel proxyModel;
+  qInfo() << QStringLiteral("Filter %1 contacts.")
+    .arg(CoreManager::getInstance()->getContactsListModel()->rowCount());
+
+  QFETCH(QString, pattern);
+  QBENCHMARK {
+    proxyModel.setFilter(pattern);
+  }
+}
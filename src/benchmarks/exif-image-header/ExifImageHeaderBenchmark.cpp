@@ -0,0 +1,95 @@
+/*
+ * ExifImageHeaderBenchmark.cpp
+ * Copyright (C) 2026  Belledonne Communications, Grenoble, France
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *  Created on: October 17, 2026
+ */
+
+#include <QBuffer>
+#include <QDataStream>
+#include <QImage>
+#include <QTest>
+
+#include "../../utils/QExifImageHeader.h"
+
+#include "ExifImageHeaderBenchmark.hpp"
+
+// =============================================================================
+
+// A photo jpeg: an EXIF segment with a TIFF header and one image IFD
+// (`Make` and `Orientation`), then the image.
+static QByteArray createJpeg () {
+  QByteArray tiff;
+  {
+    QDataStream stream(&tiff, QIODevice::WriteOnly);
+    stream.setByteOrder(QDataStream::LittleEndian);
+
+    stream.writeRawData("II", 2);
+    stream << quint16(0x002A) << quint32(8);
+
+    stream << quint16(2);
+    stream << quint16(QExifImageHeader::Make) << quint16(QExifValue::Ascii) << quint32(4);
+    stream.writeRawData("abc", 4);
+    stream << quint16(QExifImageHeader::Orientation) << quint16(QExifValue::Short) << quint32(1)
+      << quint16(6) << quint16(0);
+
+    // No next IFD.
+    stream << quint32(0);
+  }
+
+  const QByteArray payload = QByteArray("Exif\0\0", 6) + tiff;
+  QByteArray segment;
+  {
+    QDataStream stream(&segment, QIODevice::WriteOnly);
+    stream << quint8(0xFF) << quint8(0xE1) << quint16(payload.size() + 2);
+    stream.writeRawData(payload.constData(), payload.size());
+  }
+
+  QByteArray jpeg;
+  QBuffer buffer(&jpeg);
+  buffer.open(QIODevice::WriteOnly);
+
+  QImage image(64, 64, QImage::Format_RGB32);
+  image.fill(Qt::red);
+  image.save(&buffer, "jpg");
+
+  // After the start of image marker.
+  return jpeg.left(2) + segment + jpeg.mid(2);
+}
+
+// -----------------------------------------------------------------------------
+
+void ExifImageHeaderBenchmark::initTestCase () {
+  QVERIFY(mFile.open());
+  mFile.write(::createJpeg());
+  QVERIFY(mFile.flush());
+}
+
+void ExifImageHeaderBenchmark::benchmarkReadImageTag () {
+  QBENCHMARK {
+    quint32 value;
+    QExifImageHeader::readImageTag(mFile.fileName(), QExifImageHeader::Orientation, value);
+  }
+}
+
+void ExifImageHeaderBenchmark::benchmarkLoadFromJpeg () {
+  QBENCHMARK {
+    QExifImageHeader header;
+    if (header.loadFromJpeg(mFile.fileName()))
+      header.value(QExifImageHeader::Orientation).toShort();
+  }
+}
@@ -0,0 +1,47 @@
+/*
+ * ExifImageHeaderBenchmark.hpp
+ * Copyright (C) 2026  Belledonne Communications, Grenoble, France
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *  Created on: October 17, 2026
+ */
+
+#ifndef EXIF_IMAGE_HEADER_BENCHMARK_H_
+#define EXIF_IMAGE_HEADER_BENCHMARK_H_
+
+#include <QObject>
+#include <QTemporaryFile>
+
+// =============================================================================
+
+class ExifImageHeaderBenchmark : public QObject {
+  Q_OBJECT;
+
+public:
+  ExifImageHeaderBenchmark () = default;
+  ~ExifImageHeaderBenchmark () = default;
+
+private slots:
+  void initTestCase ();
+
+  void benchmarkReadImageTag ();
+  void benchmarkLoadFromJpeg ();
+
+private:
+  QTemporaryFile mFile;
+};
+
+#endif // ifndef EXIF_IMAGE_HEADER_BENCHMARK_H_
@@ -0,0 +1,81 @@
+/*
+ * ImageProviderBenchmark.cpp
+ * Copyright (C) 2026  Belledonne Communications, Grenoble, France
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *  Created on: October 17, 2026
+ */
+
+#include <QDir>
+#include <QFile>
+#include <QPainter>
+#include <QSvgRenderer>
+#include <QTest>
+
+#include "../../app/providers/ImageProvider.hpp"
+
+#include "ImageProviderBenchmark.hpp"
+
+#define BUNDLED_IMAGES_PATH ":/assets/images"
+#define IMAGE_SIZE 48
+
+// =============================================================================
+
+static QStringList getBundledImageNames () {
+  return QDir(BUNDLED_IMAGES_PATH).entryList({ "*.svg" }, QDir::Files);
+}
+
+// -----------------------------------------------------------------------------
+
+// Path of an image already rasterized: what most of the QML requests cost.
+void ImageProviderBenchmark::benchmarkRequestCachedImages () {
+  const QStringList names = ::getBundledImageNames();
+  QVERIFY(!names.isEmpty());
+
+  ImageProvider provider;
+  const QSize requestedSize(IMAGE_SIZE, IMAGE_SIZE);
+  QSize size;
+
+  for (const auto &name : names)
+    provider.requestImage(name, &size, requestedSize);
+
+  QBENCHMARK {
+    for (const auto &name : names)
+      provider.requestImage(name, &size, requestedSize);
+  }
+}
+
+// Path of an image never rasterized: svg parsing and painting, without any cache.
+void ImageProviderBenchmark::benchmarkRenderImages () {
+  QList<QByteArray> contents;
+  for (const auto &name : ::getBundledImageNames()) {
+    QFile file(QDir(BUNDLED_IMAGES_PATH).filePath(name));
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    contents << file.readAll();
+  }
+  QVERIFY(!contents.isEmpty());
+
+  QBENCHMARK {
+    for (const auto &content : contents) {
+      QSvgRenderer renderer(content);
+      QImage image(IMAGE_SIZE, IMAGE_SIZE, QImage::Format_ARGB32);
+      image.fill(0x00000000);
+
+      QPainter painter(&image);
+      renderer.render(&painter);
+    }
+  }
+}
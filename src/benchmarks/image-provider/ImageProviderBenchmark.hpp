@@ -0,0 +1,41 @@
+/*
+ * ImageProviderBenchmark.hpp
+ * Copyright (C) 2026  Belledonne Communications, Grenoble, France
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *  Created on: October 17, 2026
+ */
+
+#ifndef IMAGE_PROVIDER_BENCHMARK_H_
+#define IMAGE_PROVIDER_BENCHMARK_H_
+
+#include <QObject>
+
+// =============================================================================
+
+class ImageProviderBenchmark : public QObject {
+  Q_OBJECT;
+
+public:
+  ImageProviderBenchmark () = default;
+  ~ImageProviderBenchmark () = default;
+
+private slots:
+  void benchmarkRequestCachedImages ();
+  void benchmarkRenderImages ();
+};
+
+#endif // ifndef IMAGE_PROVIDER_BENCHMARK_H_
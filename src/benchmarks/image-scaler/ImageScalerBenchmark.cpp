@@ -0,0 +1,65 @@
+/*
+ * ImageScalerBenchmark.cpp
+ * Copyright (C) 2026  Belledonne Communications, Grenoble, France
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *  Created on: October 17, 2026
+ */
+
+#include <QTest>
+
+#include "../../utils/ImageScaler.hpp"
+
+#include "ImageScalerBenchmark.hpp"
+
+// A photo from a phone.
+#define IMAGE_WIDTH 4000
+#define IMAGE_HEIGHT 3000
+
+// =============================================================================
+
+// Gradients with a checkerboard, like a photo with details.
+static QImage createImage (int width, int height) {
+  QImage image(width, height, QImage::Format_RGB32);
+  for (int y = 0; y < height; ++y) {
+    QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(y));
+    for (int x = 0; x < width; ++x) {
+      const int checker = ((x / 7 + y / 7) % 2) * 64;
+      line[x] = qRgb(
+        (x * 191) / width + checker,
+        (y * 191) / height + checker,
+        ((x + y) * 95) / (width + height) + checker
+      );
+    }
+  }
+  return image;
+}
+
+// -----------------------------------------------------------------------------
+
+void ImageScalerBenchmark::benchmarkScaled () {
+  const QImage image = ::createImage(IMAGE_WIDTH, IMAGE_HEIGHT);
+  QBENCHMARK {
+    ImageScaler::scaled(image, QSize(100, 100));
+  }
+}
+
+void ImageScalerBenchmark::benchmarkQtScaled () {
+  const QImage image = ::createImage(IMAGE_WIDTH, IMAGE_HEIGHT);
+  QBENCHMARK {
+    image.scaled(100, 100, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+  }
+}
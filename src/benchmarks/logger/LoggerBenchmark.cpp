@@ -0,0 +1,84 @@
+/*
+ * LoggerBenchmark.cpp
+ * Copyright (C) 2026  Belledonne Communications, Grenoble, France
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *  Created on: October 17, 2026
+ */
+
+#include <bctoolbox/logging.h>
+#include <QDateTime>
+#include <QTest>
+
+#include "../../app/logger/Logger.hpp"
+
+#include "LoggerBenchmark.hpp"
+
+#define LOG_DOMAIN "belle-sip"
+#define LOG_MESSAGE "channel [0x55d5c1a3e0]: message sent to [UDP://sip.linphone.org:5060], size: [512] bytes"
+
+// Lines logged by a call setup, roughly.
+#define LOG_LINES 1000
+
+// =============================================================================
+
+// The benchmarks log the same lines in loop, most of them would be dropped.
+void LoggerBenchmark::initTestCase () {
+  Logger::getInstance()->setRateLimitEnabled(false);
+}
+
+void LoggerBenchmark::cleanupTestCase () {
+  Logger::getInstance()->setRateLimitEnabled(true);
+}
+
+// -----------------------------------------------------------------------------
+
+void LoggerBenchmark::benchmarkFormatLine () {
+  QBENCHMARK {
+    Logger::formatLine(BCTBX_LOG_MESSAGE, LOG_DOMAIN, nullptr, nullptr, LOG_MESSAGE);
+  }
+}
+
+// Per-line cost of the previous implementation: local time formatted
+// with `QDateTime` and a message duplicated on the heap for each line.
+void LoggerBenchmark::benchmarkFormatLineLegacy () {
+  char line[512];
+
+  QBENCHMARK {
+    const QByteArray dateTime = QDateTime::currentDateTime().toString("HH:mm:ss:zzz").toLocal8Bit();
+    char *msg = bctbx_strdup_printf("%s", LOG_MESSAGE);
+    snprintf(line, sizeof line, "[%s][Info]Core:%s: %s\n", dateTime.constData(), LOG_DOMAIN, msg);
+    bctbx_free(msg);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+// Full path of the core messages: level filter, rate limit, formatting and collection.
+void LoggerBenchmark::benchmarkCoreMessages () {
+  QBENCHMARK {
+    for (int i = 0; i < LOG_LINES; ++i)
+      bctbx_log(LOG_DOMAIN, BCTBX_LOG_MESSAGE, "%s %d", LOG_MESSAGE, i);
+  }
+}
+
+// Full path of the app messages: Qt message handler, then the core logger.
+void LoggerBenchmark::benchmarkQtMessages () {
+  QBENCHMARK {
+    for (int i = 0; i < LOG_LINES; ++i)
+      qInfo() << QStringLiteral("Message sent: `%1`.").arg(i);
+  }
+}
@@ -0,0 +1,148 @@
+/*
+ * main.cpp
+ * Copyright (C) 2026  Belledonne Communications, Grenoble, France
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *  Created on: October 17, 2026
+ */
+
+#include <QTest>
+#include <QTimer>
+
+#include "../app/AppController.hpp"
+#include "../components/core/CoreManager.hpp"
+#include "../utils/Utils.hpp"
+
+#include "chat-model/ChatModelBenchmark.hpp"
+#include "contacts-list/ContactsListBenchmark.hpp"
+#include "exif-image-header/ExifImageHeaderBenchmark.hpp"
+#include "image-provider/ImageProviderBenchmark.hpp"
+#include "image-scaler/ImageScalerBenchmark.hpp"
+#include "logger/LoggerBenchmark.hpp"
+#include "scrolling/ScrollingBenchmark.hpp"
+#include "sip-addresses/SipAddressesBenchmark.hpp"
+#include "svg-template/SvgTemplateBenchmark.hpp"
+#include "timeline/TimelineBenchmark.hpp"
+
+#define CORE_START_TIMEOUT 30000
+
+// =============================================================================
+
+// Sorted by name, so the results are always written in the same order.
+static QMap<QString, QObject *> initializeBenchmarks () {
+  QMap<QString, QObject *> map;
+  map["chat-model"] = new ChatModelBenchmark();
+  map["contacts-list"] = new ContactsListBenchmark();
+  map["exif-image-header"] = new ExifImageHeaderBenchmark();
+  map["image-provider"] = new ImageProviderBenchmark();
+  map["image-scaler"] = new ImageScalerBenchmark();
+  map["logger"] = new LoggerBenchmark();
+  map["scrolling"] = new ScrollingBenchmark();
+  map["sip-addresses"] = new SipAddressesBenchmark();
+  map["svg-template"] = new SvgTemplateBenchmark();
+  map["timeline"] = new TimelineBenchmark();
+  return map;
+}
+
+// QTest truncates the output files on each run, so each benchmark writes in
+// its own files: `-o results.csv,csv` gives `results-<benchmark>.csv`.
+static QStringList getBenchmarkArgs (const QStringList &args, const QString &benchmarkName) {
+  QStringList benchmarkArgs;
+  for (int i = 0; i < args.size(); ++i) {
+    QString arg = args[i];
+    if (i > 0 && args[i - 1] == "-o") {
+      const int formatSeparator = arg.lastIndexOf(',');
+      const QString fileName = formatSeparator == -1 ? arg : arg.left(formatSeparator);
+      if (fileName != "-") {
+        const int dot = fileName.lastIndexOf('.');
+        const int extension = dot > fileName.lastIndexOf('/') ? dot : fileName.length();
+        arg.insert(extension, "-" + benchmarkName);
+      }
+    }
+    benchmarkArgs << arg;
+  }
+  return benchmarkArgs;
+}
+
+// -----------------------------------------------------------------------------
+
+// Usage: linphone-bench [benchmark] [qtest options]
+// Without `-o` option, the results are written on stdout in csv, one line per
+// benchmark, so two runs can be compared. The logs are written on stderr.
+// With a `-o <file>,<format>` option, one file is written per benchmark.
+int main (int argc, char *argv[]) {
+  // Windows are rendered offscreen, run without display.
+  if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+
+  // Render in the main thread: a measured frame covers the scroll handling,
+  // the delegates creation and the render.
+  if (qEnvironmentVariableIsEmpty("QSG_RENDER_LOOP"))
+    qputenv("QSG_RENDER_LOOP", "basic");
+
+  int fakeArgc = 1;
+  AppController controller(fakeArgc, argv);
+  App *app = controller.getApp();
+  if (app->isSecondary())
+    qFatal("Unable to run benchmark with secondary app.");
+
+  const QMap<QString, QObject *> benchmarks = initializeBenchmarks();
+
+  QMap<QString, QObject *> selectedBenchmarks;
+  int argi = 1;
+  if (argc > 1 && argv[1][0] != '-') {
+    const QString benchmarkName = ::Utils::coreStringToAppString(argv[1]);
+    QObject *benchmark = benchmarks.value(benchmarkName);
+    if (!benchmark) {
+      qWarning() << QStringLiteral("Unable to run invalid benchmark: `%1`.").arg(benchmarkName);
+      return EXIT_FAILURE;
+    }
+    selectedBenchmarks[benchmarkName] = benchmark;
+    ++argi;
+  } else
+    selectedBenchmarks = benchmarks;
+
+  QStringList args(::Utils::coreStringToAppString(argv[0]));
+  for (; argi < argc; ++argi)
+    args << ::Utils::coreStringToAppString(argv[argi]);
+  if (!args.contains("-o"))
+    args << "-o" << "-,csv";
+
+  app->initContentApp();
+
+  int benchmarksRet = 0;
+  QObject::connect(CoreManager::getInstance()->getHandlers().get(), &CoreHandlers::coreStarted, app, [&] {
+    for (auto it = selectedBenchmarks.cbegin(); it != selectedBenchmarks.cend(); ++it)
+      benchmarksRet |= QTest::qExec(it.value(), ::getBenchmarkArgs(args, it.key()));
+
+    QCoreApplication::quit();
+  }, Qt::QueuedConnection);
+
+  QTimer::singleShot(CORE_START_TIMEOUT, app, [] {
+    if (!CoreManager::getInstance()->started())
+      qFatal("Unable to run benchmarks, core not started.");
+  });
+
+  int ret = app->exec();
+
+  for (auto &benchmark : benchmarks)
+    delete benchmark;
+
+  if (benchmarksRet)
+    qWarning() << QStringLiteral("One or many benchmarks are failed.");
+
+  return benchmarksRet || ret;
+}
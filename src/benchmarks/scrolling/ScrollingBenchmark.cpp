@@ -0,0 +1,296 @@
+/*
+ * ScrollingBenchmark.cpp
+ * Copyright (C) 2026  Belledonne Communications, Grenoble, France
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *  Created on: October 17, 2026
+ */
+#include <algorithm>
+#include <cmath>
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QQmlComponent>
+#include <QQmlEngine>
+#include <QQuickItem>
+#include <QQuickWindow>
+#include <QSignalSpy>
+#include <QTest>
+
+#include "../../app/App.hpp"
+#include "../../components/core/CoreManager.hpp"
+#include "../../utils/Utils.hpp"
+
+#include "ScrollingBenchmark.hpp"
+
+// Pixels scrolled between two frames.
+#define SCROLL_STEP 40
+
+// Stop after this number of frames, even if the view is not fully scrolled.
+#define MAX_FRAMES 3000
+
+// Frames to wait at the end of the view, entries may be loaded lazily.
+#define END_FRAMES 2
+
+#define FRAME_TIMEOUT 5000
+
+// Let the view be positioned before scrolling. (`Chat.qml` binds to end with a timer.)
+#define SETTLE_DELAY 500
+
+using namespace std;
+
+// =============================================================================
+
+namespace {
+  // Frame time: from the scroll step to the frame swap. It includes the delegates
+  // creation, the polish, the sync and the render of the frame.
+  // Render time: between `beforeRendering` and `afterRendering` of the scenegraph.
+  struct ScrollingResult {
+    QVector<qint64> frameTimes;
+    QVector<qint64> renderTimes;
+  };
+}
+
+static const char ChatQml[] =
+  "import QtQuick 2.7\n"
+  "import QtQuick.Window 2.2\n"
+  "import Linphone 1.0\n"
+  "Window {\n"
+  "  id: window\n"
+  "  property string sipAddress\n"
+  "  width: 800\n"
+  "  height: 600\n"
+  "  Chat {\n"
+  "    anchors.fill: parent\n"
+  "    proxyModel: ChatProxyModel { sipAddress: window.sipAddress }\n"
+  "  }\n"
+  "}\n";
+
+static const char TimelineQml[] =
+  "import QtQuick 2.7\n"
+  "import QtQuick.Window 2.2\n"
+  "import Linphone 1.0\n"
+  "Window {\n"
+  "  width: 300\n"
+  "  height: 600\n"
+  "  Timeline {\n"
+  "    anchors.fill: parent\n"
+  "    model: TimelineModel\n"
+  "  }\n"
+  "}\n";
+
+// -----------------------------------------------------------------------------
+
+static QQuickWindow *createWindow (const char *qml, const QVariantMap &properties = QVariantMap()) {
+  QQmlEngine *engine = App::getInstance()->getEngine();
+  QQmlComponent component(engine);
+  component.setData(qml, QUrl());
+
+  QObject *object = component.beginCreate(engine->rootContext());
+  if (!object) {
+    qWarning() << QStringLiteral("Unable to create window: `%1`.").arg(component.errorString());
+    return nullptr;
+  }
+
+  for (auto it = properties.cbegin(); it != properties.cend(); ++it)
+    object->setProperty(it.key().toLatin1().constData(), it.value());
+  component.completeCreate();
+
+  QQuickWindow *window = qobject_cast<QQuickWindow *>(object);
+  if (!window)
+    delete object;
+  return window;
+}
+
+static QQuickItem *findListView (QQuickWindow *window) {
+  // Depth-first: the view is found before the list views of its delegates.
+  for (QQuickItem *item : window->contentItem()->findChildren<QQuickItem *>())
+    if (item->inherits("QQuickListView"))
+      return item;
+  return nullptr;
+}
+
+static bool waitForFrame (QQuickWindow *window) {
+  QSignalSpy spy(window, &QQuickWindow::frameSwapped);
+  window->update();
+  return spy.wait(FRAME_TIMEOUT);
+}
+
+// Scrolls the list view of the window by `step` pixels at each frame until
+// the end of the content is reached. (The beginning if `step` is negative.)
+static ScrollingResult scroll (QQuickWindow *window, qreal step) {
+  ScrollingResult result;
+
+  window->show();
+  if (!QTest::qWaitForWindowExposed(window)) {
+    qWarning() << QStringLiteral("Unable to expose window.");
+    return result;
+  }
+  QTest::qWait(SETTLE_DELAY);
+
+  QQuickItem *listView = ::findListView(window);
+  if (!listView) {
+    qWarning() << QStringLiteral("Unable to find list view.");
+    return result;
+  }
+
+  // Do not go back to the end of the chat after each loaded page.
+  if (listView->metaObject()->indexOfProperty("bindToEnd") != -1)
+    listView->setProperty("bindToEnd", false);
+
+  // The scenegraph may render in a dedicated thread.
+  QMutex mutex;
+  QElapsedTimer renderTimer;
+  QMetaObject::Connection beforeRendering = QObject::connect(window, &QQuickWindow::beforeRendering, [&] {
+    QMutexLocker locker(&mutex);
+    renderTimer.start();
+  });
+  QMetaObject::Connection afterRendering = QObject::connect(window, &QQuickWindow::afterRendering, [&] {
+    QMutexLocker locker(&mutex);
+    result.renderTimes << renderTimer.nsecsElapsed();
+  });
+
+  const char *edge = step < 0 ? "atYBeginning" : "atYEnd";
+  QElapsedTimer frameTimer;
+  for (int endFrames = 0; result.frameTimes.size() < MAX_FRAMES;) {
+    if (listView->property(edge).toBool()) {
+      if (++endFrames > END_FRAMES || !::waitForFrame(window))
+        break;
+      continue;
+    }
+    endFrames = 0;
+
+    const qreal originY = listView->property("originY").toReal();
+    const qreal maxContentY = originY + listView->property("contentHeight").toReal() - listView->height();
+    const qreal contentY = qBound(originY, listView->property("contentY").toReal() + step, qMax(originY, maxContentY));
+
+    frameTimer.start();
+    listView->setProperty("contentY", contentY);
+    if (!::waitForFrame(window)) {
+      qWarning() << QStringLiteral("No frame rendered after scroll.");
+      break;
+    }
+    result.frameTimes << frameTimer.nsecsElapsed();
+  }
+
+  QObject::disconnect(beforeRendering);
+  QObject::disconnect(afterRendering);
+  window->hide();
+
+  QMutexLocker locker(&mutex);
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+
+static qint64 getPercentile (QVector<qint64> values, qreal percentile) {
+  if (values.isEmpty())
+    return 0;
+
+  sort(values.begin(), values.end());
+  const int index = int(ceil(percentile / 100 * values.size())) - 1;
+  return values[qBound(0, index, values.size() - 1)];
+}
+
+static inline qreal toMilliseconds (qint64 nsecs) {
+  return qreal(nsecs) / 1000000;
+}
+
+static void printResult (const QString &name, const ScrollingResult &result) {
+  qInfo() << QStringLiteral("%1: %2 frames, p50 %3 ms, p95 %4 ms, p99 %5 ms, longest %6 ms (render p50 %7 ms, longest %8 ms).")
+    .arg(name)
+    .arg(result.frameTimes.size())
+    .arg(::toMilliseconds(::getPercentile(result.frameTimes, 50)))
+    .arg(::toMilliseconds(::getPercentile(result.frameTimes, 95)))
+    .arg(::toMilliseconds(::getPercentile(result.frameTimes, 99)))
+    .arg(::toMilliseconds(::getPercentile(result.frameTimes, 100)))
+    .arg(::toMilliseconds(::getPercentile(result.renderTimes, 50)))
+    .arg(::toMilliseconds(::getPercentile(result.renderTimes, 100)));
+}
+
+static void addPercentileRows () {
+  QTest::addColumn<qreal>("percentile");
+
+  QTest::newRow("p50") << qreal(50);
+  QTest::newRow("p95") << qreal(95);
+  QTest::newRow("p99") << qreal(99);
+  QTest::newRow("longest") << qreal(100);
+}
+
+static inline void setBenchmarkResult (const QVector<qint64> &frameTimes, qreal percentile) {
+  QTest::setBenchmarkResult(::toMilliseconds(::getPercentile(frameTimes, percentile)), QTest::WalltimeMilliseconds);
+}
+
+// -----------------------------------------------------------------------------
+
+void ScrollingBenchmark::benchmarkChatScrolling_data () {
+  ::addPercentileRows();
+}
+
+// Scrolls the biggest conversation from the end to the first message.
+void ScrollingBenchmark::benchmarkChatScrolling () {
+  QFETCH(qreal, percentile);
+
+  if (mChatFrameTimes.isEmpty()) {
+    shared_ptr<linphone::ChatRoom> biggestChatRoom;
+    for (const auto &chatRoom : CoreManager::getInstance()->getCore()->getChatRooms())
+      if (!biggestChatRoom || chatRoom->getHistorySize() > biggestChatRoom->getHistorySize())
+        biggestChatRoom = chatRoom;
+
+    if (!biggestChatRoom || !biggestChatRoom->getHistorySize())
+      QSKIP("No chat history in this profile.");
+
+    const QString sipAddress = ::Utils::coreStringToAppString(
+      biggestChatRoom->getPeerAddress()->asStringUriOnly()
+    );
+    qInfo() << QStringLiteral("Scroll conversation of %1 messages.").arg(biggestChatRoom->getHistorySize());
+
+    QScopedPointer<QQuickWindow> window(::createWindow(ChatQml, { { "sipAddress", sipAddress } }));
+    QVERIFY(window);
+
+    const ScrollingResult result = ::scroll(window.data(), -SCROLL_STEP);
+    if (result.frameTimes.isEmpty())
+      QSKIP("Nothing to scroll in this conversation.");
+
+    ::printResult(QStringLiteral("Chat scrolling"), result);
+    mChatFrameTimes = result.frameTimes;
+  }
+
+  ::setBenchmarkResult(mChatFrameTimes, percentile);
+}
+
+void ScrollingBenchmark::benchmarkTimelineScrolling_data () {
+  ::addPercentileRows();
+}
+
+// Scrolls the timeline from the most recent entry to the oldest.
+void ScrollingBenchmark::benchmarkTimelineScrolling () {
+  QFETCH(qreal, percentile);
+
+  if (mTimelineFrameTimes.isEmpty()) {
+    QScopedPointer<QQuickWindow> window(::createWindow(TimelineQml));
+    QVERIFY(window);
+
+    const ScrollingResult result = ::scroll(window.data(), SCROLL_STEP);
+    if (result.frameTimes.isEmpty())
+      QSKIP("Nothing to scroll in this timeline.");
+
+    ::printResult(QStringLiteral("Timeline scrolling"), result);
+    mTimelineFrameTimes = result.frameTimes;
+  }
+
+  ::setBenchmarkResult(mTimelineFrameTimes, percentile);
+}
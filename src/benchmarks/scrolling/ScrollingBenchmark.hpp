@@ -0,0 +1,50 @@
+/*
+ * ScrollingBenchmark.hpp
+ * Copyright (C) 2026  Belledonne Communications, Grenoble, France
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *  Created on: October 17, 2026
+ */
+#ifndef SCROLLING_BENCHMARK_H_
+#define SCROLLING_BENCHMARK_H_
+
+#include <QObject>
+#include <QVector>
+
+// =============================================================================
+
+class ScrollingBenchmark : public QObject {
+  Q_OBJECT;
+
+public:
+  ScrollingBenchmark () = default;
+  ~ScrollingBenchmark () = default;
+
+private slots:
+  void benchmarkChatScrolling_data ();
+  void benchmarkChatScrolling ();
+
+  void benchmarkTimelineScrolling_data ();
+  void benchmarkTimelineScrolling ();
+
+private:
+  // Frame times in nanoseconds. Measured on the first data row only,
+  // the other rows report another percentile of the same run.
+  QVector<qint64> mChatFrameTimes;
+  QVector<qint64> mTimelineFrameTimes;
+};
+
+#endif // ifndef SCROLLING_BENCHMARK_H_
@@ -0,0 +1,92 @@
+/*
+ * SvgTemplateBenchmark.cpp
+ * Copyright (C) 2026  Belledonne Communications, Grenoble, France
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *  Created on: October 17, 2026
+ */
+
+#include <QDir>
+#include <QMetaProperty>
+#include <QTest>
+
+#include "../../components/other/colors/Colors.hpp"
+#include "../../utils/SvgTemplate.hpp"
+
+#include "SvgTemplateBenchmark.hpp"
+
+#define BUNDLED_IMAGES_PATH ":/assets/images"
+
+// =============================================================================
+
+static QList<QByteArray> readBundledImages () {
+  QList<QByteArray> images;
+  QDir dir(BUNDLED_IMAGES_PATH);
+  for (const auto &fileName : dir.entryList({ "*.svg" }, QDir::Files)) {
+    QFile file(dir.filePath(fileName));
+    if (file.open(QIODevice::ReadOnly))
+      images << file.readAll();
+  }
+  return images;
+}
+
+static QStringList getBundledColorNames () {
+  QStringList colorNames;
+
+  const QMetaObject &info = Colors::staticMetaObject;
+  for (int i = info.propertyOffset(); i < info.propertyCount(); ++i)
+    if (info.property(i).userType() == QMetaType::QColor)
+      colorNames << QString::fromLatin1(info.property(i).name());
+
+  return colorNames;
+}
+
+// -----------------------------------------------------------------------------
+
+void SvgTemplateBenchmark::benchmarkCompile () {
+  const QList<QByteArray> images = ::readBundledImages();
+  const QStringList colorNames = ::getBundledColorNames();
+  QVERIFY(!images.isEmpty());
+
+  QBENCHMARK {
+    for (const auto &image : images)
+      SvgTemplate::compile(image, colorNames);
+  }
+}
+
+void SvgTemplateBenchmark::benchmarkInstantiate () {
+  const QStringList colorNames = ::getBundledColorNames();
+
+  QList<SvgTemplate> svgTemplates;
+  for (const auto &image : ::readBundledImages()) {
+    svgTemplates << SvgTemplate::compile(image, colorNames);
+    QVERIFY(!svgTemplates.last().isNull());
+  }
+
+  // The color names as values, e.g. `[i]`.
+  QList<QVector<QByteArray>> colorValues;
+  for (const auto &svgTemplate : svgTemplates) {
+    QVector<QByteArray> values;
+    for (const auto &colorName : svgTemplate.getColorNames())
+      values << "[" + colorName.toLatin1() + "]";
+    colorValues << values;
+  }
+
+  QBENCHMARK {
+    for (int i = 0; i < svgTemplates.size(); ++i)
+      svgTemplates[i].instantiate(colorValues[i]);
+  }
+}
@@ -384,9 +384,11 @@ void AssistantModel::setConfigFilename (const QString &configFilename) {
   QString configPath = ::Utils::coreStringToAppString(Paths::getAssistantConfigDirPath()) + configFilename;
   qInfo() << QStringLiteral("Set config on assistant: `%1`.").arg(configPath);
 
-  CoreManager::getInstance()->getCore()->getConfig()->loadFromXmlFile(
+  CoreManager *coreManager = CoreManager::getInstance();
+  coreManager->getCore()->getConfig()->loadFromXmlFile(
     ::Utils::appStringToCoreString(configPath)
   );
+  coreManager->getSettingsModel()->reloadSnapshot();
 
   emit configFilenameChanged(configFilename);
 }
@@ -21,6 +21,7 @@
  */
 
 #include <QDateTime>
+#include <QMetaEnum>
 #include <QTimer>
 
 #include "../../app/App.hpp"
@@ -86,6 +87,56 @@ void CallModel::setRecordFile (shared_ptr<linphone::CallParams> &callParams) {
   );
 }
 
+static QString getIpFamilyName (linphone::AddressFamily family) {
+  switch (family) {
+    case linphone::AddressFamilyInet:
+      return QStringLiteral("IPv4");
+    case linphone::AddressFamilyInet6:
+      return QStringLiteral("IPv6");
+    default:
+      break;
+  }
+
+  return QStringLiteral("Unknown");
+}
+
+static const char *getIceStateId (linphone::IceState state) {
+  switch (state) {
+    case linphone::IceStateNotActivated:
+      return QT_TRANSLATE_NOOP("CallModel", "iceStateNotActivated");
+    case linphone::IceStateFailed:
+      return QT_TRANSLATE_NOOP("CallModel", "iceStateFailed");
+    case linphone::IceStateInProgress:
+      return QT_TRANSLATE_NOOP("CallModel", "iceStateInProgress");
+    case linphone::IceStateReflexiveConnection:
+      return QT_TRANSLATE_NOOP("CallModel", "iceStateReflexiveConnection");
+    case linphone::IceStateHostConnection:
+      return QT_TRANSLATE_NOOP("CallModel", "iceStateHostConnection");
+    case linphone::IceStateRelayConnection:
+      return QT_TRANSLATE_NOOP("CallModel", "iceStateRelayConnection");
+  }
+
+  return QT_TRANSLATE_NOOP("CallModel", "iceStateInvalid");
+}
+
+// Raw values of the stats, without units.
+static QVariantMap getStatsValues (const shared_ptr<const linphone::CallStats> &callStats) {
+  QVariantMap values;
+  values["uploadBandwidth"] = double(callStats->getUploadBandwidth());
+  values["downloadBandwidth"] = double(callStats->getDownloadBandwidth());
+  values["iceState"] = QString::fromLatin1(::getIceStateId(callStats->getIceState()));
+  values["ipFamily"] = ::getIpFamilyName(callStats->getIpFamilyOfRemote());
+  values["senderLossRate"] = double(callStats->getSenderLossRate());
+  values["receiverLossRate"] = double(callStats->getReceiverLossRate());
+
+  if (callStats->getType() == linphone::StreamTypeAudio)
+    values["jitterBufferSize"] = double(callStats->getJitterBufferSizeMs());
+  else
+    values["estimatedDownloadBandwidth"] = double(callStats->getEstimatedDownloadBandwidth());
+
+  return values;
+}
+
 void CallModel::updateStats (const shared_ptr<const linphone::CallStats> &callStats) {
   switch (callStats->getType()) {
     case linphone::StreamTypeText:
@@ -94,9 +145,11 @@ void CallModel::updateStats (const shared_ptr<const linphone::CallStats> &callSt
 
     case linphone::StreamTypeAudio:
       updateStats(callStats, mAudioStats);
+      mAudioStatsValues = ::getStatsValues(callStats);
       break;
     case linphone::StreamTypeVideo:
       updateStats(callStats, mVideoStats);
+      mVideoStatsValues = ::getStatsValues(callStats);
       break;
   }
 
@@ -210,7 +263,9 @@ void CallModel::takeSnapshot () {
 
   const QString filePath = CoreManager::getInstance()->getSettingsModel()->getSavedScreenshotsFolder() + newName;
   mCall->takeVideoSnapshot(::Utils::appStringToCoreString(filePath));
-  App::getInstance()->getNotifier()->notifySnapshotWasTaken(filePath);
+  Notifier *notifier = App::getInstance()->getNotifier();
+  if (notifier)
+    notifier->notifySnapshotWasTaken(filePath);
 }
 
 void CallModel::startRecording () {
@@ -234,9 +289,11 @@ void CallModel::stopRecording () {
   mRecording = false;
   mCall->stopRecording();
 
-  App::getInstance()->getNotifier()->notifyRecordingCompleted(
-    ::Utils::coreStringToAppString(mCall->getParams()->getRecordFile())
-  );
+  Notifier *notifier = App::getInstance()->getNotifier();
+  if (notifier)
+    notifier->notifyRecordingCompleted(
+      ::Utils::coreStringToAppString(mCall->getParams()->getRecordFile())
+    );
 
   emit recordingChanged(false);
 }
@@ -591,6 +648,26 @@ QString CallModel::getSecuredString () const {
 
 // -----------------------------------------------------------------------------
 
+QVariantMap CallModel::getDescription () const {
+  QVariantMap description;
+  description["sipAddress"] = getSipAddress();
+  description["status"] = QString::fromLatin1(QMetaEnum::fromType<CallStatus>().valueToKey(getStatus()));
+  description["isOutgoing"] = isOutgoing();
+  description["isInConference"] = isInConference();
+  description["duration"] = getDuration();
+  description["quality"] = double(getQuality());
+  description["microMuted"] = getMicroMuted();
+  description["pausedByUser"] = getPausedByUser();
+  description["videoEnabled"] = getVideoEnabled();
+  description["recording"] = getRecording();
+  description["encryption"] = QString::fromLatin1(QMetaEnum::fromType<CallEncryption>().valueToKey(getEncryption()));
+  description["audioStats"] = mAudioStatsValues;
+  description["videoStats"] = mVideoStatsValues;
+  return description;
+}
+
+// -----------------------------------------------------------------------------
+
 QVariantList CallModel::getAudioStats () const {
   return mAudioStats;
 }
@@ -623,18 +700,7 @@ void CallModel::updateStats (const shared_ptr<const linphone::CallStats> &callSt
       return;
   }
 
-  QString family;
-  switch (callStats->getIpFamilyOfRemote()) {
-    case linphone::AddressFamilyInet:
-      family = QStringLiteral("IPv4");
-      break;
-    case linphone::AddressFamilyInet6:
-      family = QStringLiteral("IPv6");
-      break;
-    default:
-      family = QStringLiteral("Unknown");
-      break;
-  }
+  const QString family = ::getIpFamilyName(callStats->getIpFamilyOfRemote());
 
   statsList.clear();
 
@@ -684,20 +750,5 @@ void CallModel::updateStats (const shared_ptr<const linphone::CallStats> &callSt
 // -----------------------------------------------------------------------------
 
 QString CallModel::iceStateToString (linphone::IceState state) const {
-  switch (state) {
-    case linphone::IceStateNotActivated:
-      return tr("iceStateNotActivated");
-    case linphone::IceStateFailed:
-      return tr("iceStateFailed");
-    case linphone::IceStateInProgress:
-      return tr("iceStateInProgress");
-    case linphone::IceStateReflexiveConnection:
-      return tr("iceStateReflexiveConnection");
-    case linphone::IceStateHostConnection:
-      return tr("iceStateHostConnection");
-    case linphone::IceStateRelayConnection:
-      return tr("iceStateRelayConnection");
-  }
-
-  return tr("iceStateInvalid");
+  return tr(::getIceStateId(state));
 }
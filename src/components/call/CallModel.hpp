@@ -93,6 +93,9 @@ public:
     return mCall;
   }
 
+  // State and latest stats, not translated. Used by the CLI queries.
+  QVariantMap getDescription () const;
+
   QString getSipAddress () const;
 
   bool isInConference () const {
@@ -209,6 +212,8 @@ private:
 
   QVariantList mAudioStats;
   QVariantList mVideoStats;
+  QVariantMap mAudioStatsValues;
+  QVariantMap mVideoStatsValues;
 
   std::shared_ptr<linphone::Call> mCall;
 };
@@ -226,7 +226,7 @@ void CallsListModel::addCall (const shared_ptr<linphone::Call> &call) {
 
   CallModel *callModel = new CallModel(call);
   qInfo() << QStringLiteral("Add call:") << callModel;
-  App::getInstance()->getEngine()->setObjectOwnership(callModel, QQmlEngine::CppOwnership);
+  QQmlEngine::setObjectOwnership(callModel, QQmlEngine::CppOwnership);
 
   // This connection is (only) useful for `CallsListProxyModel`.
   QObject::connect(callModel, &CallModel::isInConferenceChanged, this, [this, callModel](bool) {
@@ -22,6 +22,7 @@
 
 #include <algorithm>
 
+#include <QBuffer>
 #include <QDateTime>
 #include <QDesktopServices>
 #include <QFileInfo>
@@ -30,10 +31,11 @@
 #include <QMimeDatabase>
 
 #include "../../app/App.hpp"
-#include "../../app/paths/Paths.hpp"
 #include "../../app/providers/ThumbnailProvider.hpp"
-#include "../../utils/Utils.hpp"
+#include "../../app/providers/ThumbnailStore.hpp"
+#include "../../utils/ImageScaler.hpp"
 #include "../../utils/QExifImageHeader.h"
+#include "../../utils/Utils.hpp"
 #include "../core/CoreManager.hpp"
 
 #include "ChatModel.hpp"
@@ -83,14 +85,11 @@ static inline void createThumbnail (const shared_ptr<linphone::ChatMessage> &mes
     return;
 
   int rotation = 0;
-  QExifImageHeader exifImageHeader;
-  if (exifImageHeader.loadFromJpeg(thumbnailPath))
-    rotation = static_cast<int>(exifImageHeader.value(QExifImageHeader::ImageTag::Orientation).toShort());
+  quint32 orientation;
+  if (QExifImageHeader::readImageTag(thumbnailPath, QExifImageHeader::ImageTag::Orientation, orientation))
+    rotation = static_cast<int>(orientation);
 
-  QImage thumbnail = image.scaled(
-      THUMBNAIL_IMAGE_FILE_WIDTH, THUMBNAIL_IMAGE_FILE_HEIGHT,
-      Qt::KeepAspectRatio, Qt::SmoothTransformation
-    );
+  QImage thumbnail = ImageScaler::scaled(image, QSize(THUMBNAIL_IMAGE_FILE_WIDTH, THUMBNAIL_IMAGE_FILE_HEIGHT));
 
   if (rotation != 0) {
     QTransform transform;
@@ -109,7 +108,13 @@ static inline void createThumbnail (const shared_ptr<linphone::ChatMessage> &mes
   QString uuid = QUuid::createUuid().toString();
   QString fileId = QStringLiteral("%1.jpg").arg(uuid.mid(1, uuid.length() - 2));
 
-  if (!thumbnail.save(::Utils::coreStringToAppString(Paths::getThumbnailsDirPath()) + fileId, "jpg", 100)) {
+  QByteArray data;
+  QBuffer buffer(&data);
+  if (
+    !buffer.open(QIODevice::WriteOnly) ||
+    !thumbnail.save(&buffer, "jpg", 100) ||
+    !ThumbnailStore::getInstance()->insert(fileId, data)
+  ) {
     qWarning() << QStringLiteral("Unable to create thumbnail of: `%1`.").arg(thumbnailPath);
     return;
   }
@@ -121,11 +126,10 @@ static inline void removeFileMessageThumbnail (const shared_ptr<linphone::ChatMe
   if (message && message->getFileTransferInformation()) {
     message->cancelFileTransfer();
 
-    string fileId = message->getAppdata();
-    if (!fileId.empty()) {
-      QString thumbnailPath = ::Utils::coreStringToAppString(Paths::getThumbnailsDirPath() + fileId);
-      if (!QFile::remove(thumbnailPath))
-        qWarning() << QStringLiteral("Unable to remove `%1`.").arg(thumbnailPath);
+    const QString fileId = ::getFileId(message);
+    if (!fileId.isEmpty()) {
+      ThumbnailStore::getInstance()->remove(fileId);
+      ThumbnailProvider::removeFromCache(fileId);
     }
   }
 }
@@ -198,7 +202,9 @@ private:
       );
       (*it).first["wasDownloaded"] = true;
 
-      App::getInstance()->getNotifier()->notifyReceivedFileMessage(message);
+      Notifier *notifier = App::getInstance()->getNotifier();
+      if (notifier)
+        notifier->notifyReceivedFileMessage(message);
     }
 
     (*it).first["status"] = state;
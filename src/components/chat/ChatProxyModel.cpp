@@ -20,6 +20,7 @@
  *      Author: Ronan Abhamon
  */
 
+#include "../../app/providers/ThumbnailProvider.hpp"
 #include "../core/CoreManager.hpp"
 
 #include "ChatProxyModel.hpp"
@@ -60,6 +61,7 @@ private:
 // =============================================================================
 
 const int ChatProxyModel::ENTRIES_CHUNK_SIZE = 50;
+const int ChatProxyModel::THUMBNAILS_PREFETCH_SIZE = 10;
 
 ChatProxyModel::ChatProxyModel (QObject *parent) : QSortFilterProxyModel(parent) {
   setSourceModel(new ChatModelFilter(this));
@@ -120,6 +122,7 @@ void ChatProxyModel::loadMoreEntries () {
       mMaxDisplayedEntries += ENTRIES_CHUNK_SIZE;
 
     invalidateFilter();
+    mPrefetchFirstRow = mPrefetchLastRow = -1;
 
     count = rowCount() - count;
     if (count > 0)
@@ -127,11 +130,41 @@ void ChatProxyModel::loadMoreEntries () {
   }
 }
 
+void ChatProxyModel::prefetchThumbnails (int firstVisibleRow, int lastVisibleRow) {
+  const int count = rowCount();
+  if (count == 0 || firstVisibleRow < 0 || lastVisibleRow < firstVisibleRow)
+    return;
+
+  if (firstVisibleRow == mPrefetchFirstRow && lastVisibleRow == mPrefetchLastRow)
+    return;
+  mPrefetchFirstRow = firstVisibleRow;
+  mPrefetchLastRow = lastVisibleRow;
+
+  QStringList ids;
+  auto addThumbnail = [this, &ids](int row) {
+    const QString thumbnail = index(row, 0).data().toMap().value("thumbnail").toString();
+    if (!thumbnail.isEmpty())
+      ids << thumbnail.section('/', -1);
+  };
+
+  // Rows just outside the visible window, nearest first.
+  for (int i = 1; i <= THUMBNAILS_PREFETCH_SIZE; ++i) {
+    if (firstVisibleRow - i >= 0)
+      addThumbnail(firstVisibleRow - i);
+    if (lastVisibleRow + i < count)
+      addThumbnail(lastVisibleRow + i);
+  }
+
+  if (!ids.isEmpty())
+    ThumbnailProvider::prefetch(ids);
+}
+
 void ChatProxyModel::setEntryTypeFilter (ChatModel::EntryType type) {
   ChatModelFilter *chatModelFilter = static_cast<ChatModelFilter *>(sourceModel());
 
   if (chatModelFilter->getEntryTypeFilter() != type) {
     chatModelFilter->setEntryTypeFilter(type);
+    mPrefetchFirstRow = mPrefetchLastRow = -1;
     emit entryTypeFilterChanged(type);
   }
 }
@@ -150,6 +183,7 @@ QString ChatProxyModel::getSipAddress () const {
 
 void ChatProxyModel::setSipAddress (const QString &sipAddress) {
   mMaxDisplayedEntries = ENTRIES_CHUNK_SIZE;
+  mPrefetchFirstRow = mPrefetchLastRow = -1;
 
   if (mChatModel) {
     ChatModel *chatModel = mChatModel.get();
@@ -57,6 +57,9 @@ public:
 
   Q_INVOKABLE void compose ();
 
+  // Decodes in background the thumbnails of the rows around the visible ones.
+  Q_INVOKABLE void prefetchThumbnails (int firstVisibleRow, int lastVisibleRow);
+
 signals:
   void sipAddressChanged (const QString &sipAddress);
   bool isRemoteComposingChanged (bool status);
@@ -80,9 +83,14 @@ private:
 
   int mMaxDisplayedEntries = ENTRIES_CHUNK_SIZE;
 
+  // Last visible window given to `prefetchThumbnails`.
+  int mPrefetchFirstRow = -1;
+  int mPrefetchLastRow = -1;
+
   std::shared_ptr<ChatModel> mChatModel;
 
   static const int ENTRIES_CHUNK_SIZE;
+  static const int THUMBNAILS_PREFETCH_SIZE;
 };
 
 #endif // CHAT_PROXY_MODEL_H_
@@ -39,7 +39,7 @@ ConferenceHelperModel::ConferenceHelperModel (QObject *parent) : QSortFilterProx
     mConference = mCore->createConferenceWithParams(mCore->createConferenceParams());
 
   mConferenceAddModel = new ConferenceAddModel(this);
-  App::getInstance()->getEngine()->setObjectOwnership(mConferenceAddModel, QQmlEngine::CppOwnership);
+  QQmlEngine::setObjectOwnership(mConferenceAddModel, QQmlEngine::CppOwnership);
 
   QObject::connect(this, &CallsListModel::rowsRemoved, [this] {
     invalidate();
@@ -91,7 +91,7 @@ void ContactModel::setVcardModelInternal (VcardModel *vcardModel) {
   mVcardModel->mAvatarIsReadOnly = false;
   mVcardModel->mIsReadOnly = true;
 
-  App::getInstance()->getEngine()->setObjectOwnership(mVcardModel, QQmlEngine::CppOwnership);
+  QQmlEngine::setObjectOwnership(mVcardModel, QQmlEngine::CppOwnership);
 
   if (mLinphoneFriend->getVcard() != vcardModel->mVcard)
     mLinphoneFriend->setVcard(vcardModel->mVcard);
@@ -47,13 +47,12 @@ ContactsListModel::ContactsListModel (QObject *parent) : QAbstractListModel(pare
   }
 
   // Init contacts with linphone friends list.
-  QQmlEngine *engine = App::getInstance()->getEngine();
   for (const auto &linphoneFriend : mLinphoneFriends->getFriends()) {
     ContactModel *contact = new ContactModel(this, linphoneFriend);
 
     // See: http://doc.qt.io/qt-5/qtqml-cppintegration-data.html#data-ownership
     // The returned value must have a explicit parent or a QQmlEngine::CppOwnership.
-    engine->setObjectOwnership(contact, QQmlEngine::CppOwnership);
+    QQmlEngine::setObjectOwnership(contact, QQmlEngine::CppOwnership);
 
     addContact(contact);
   }
@@ -136,7 +135,7 @@ ContactModel *ContactsListModel::addContact (VcardModel *vcardModel) {
   }
 
   contact = new ContactModel(this, vcardModel);
-  App::getInstance()->getEngine()->setObjectOwnership(contact, QQmlEngine::CppOwnership);
+  QQmlEngine::setObjectOwnership(contact, QQmlEngine::CppOwnership);
 
   if (
     mLinphoneFriends->addFriend(contact->mLinphoneFriend) !=
@@ -93,8 +93,9 @@ void CoreHandlers::onCallStateChanged (
 ) {
   emit callStateChanged(call, state);
 
-  if (call->getState() == linphone::CallStateIncomingReceived)
-    App::getInstance()->getNotifier()->notifyReceivedCall(call);
+  Notifier *notifier = App::getInstance()->getNotifier();
+  if (notifier && call->getState() == linphone::CallStateIncomingReceived)
+    notifier->notifyReceivedCall(call);
 }
 
 void CoreHandlers::onCallStatsUpdated (
@@ -155,7 +156,7 @@ void CoreHandlers::onMessageReceived (
     emit messageReceived(message);
 
     const App *app = App::getInstance();
-    if (!app->hasFocus())
+    if (app->getNotifier() && !app->hasFocus())
       app->getNotifier()->notifyReceivedMessage(message);
   }
 }
@@ -242,8 +243,9 @@ void CoreHandlers::onVersionUpdateCheckResultReceived (
   const string &version,
   const string &url
 ) {
-  if (result == linphone::VersionUpdateCheckResultNewVersionAvailable)
-    App::getInstance()->getNotifier()->notifyNewVersionAvailable(
+  Notifier *notifier = App::getInstance()->getNotifier();
+  if (notifier && result == linphone::VersionUpdateCheckResultNewVersionAvailable)
+    notifier->notifyNewVersionAvailable(
       ::Utils::coreStringToAppString(version),
       ::Utils::coreStringToAppString(url)
     );
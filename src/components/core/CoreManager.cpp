@@ -25,8 +25,16 @@
 #include <QtConcurrent>
 #include <QTimer>
 
+#ifdef SQL_ENABLED
+  #include <QSqlDatabase>
+  #include <QSqlError>
+  #include <QSqlQuery>
+#endif // ifdef SQL_ENABLED
+
 #include "../../app/paths/Paths.hpp"
+#include "../../app/providers/ThumbnailStore.hpp"
 #include "../../utils/Utils.hpp"
+#include "../sound-player/SoundFilesCache.hpp"
 
 #if defined(Q_OS_LINUX)
   #include "messages-count-notifier/MessagesCountNotifierLinux.hpp"
@@ -40,6 +48,12 @@
 
 #define CBS_CALL_INTERVAL 20
 
+// Delay before the removal of the thumbnails without message. (In ms.)
+#define THUMBNAILS_GC_DELAY 60000
+
+#define THUMBNAILS_GC_CONNECTION_NAME "thumbnails-gc"
+#define THUMBNAILS_GC_BUSY_TIMEOUT 5000
+
 #define DOWNLOAD_URL "https://www.linphone.org/technical-corner/linphone/downloads"
 
 using namespace std;
@@ -73,8 +87,12 @@ CoreManager::CoreManager (QObject *parent, const QString &configPath) :
     mInstance->mSettingsModel = new SettingsModel(mInstance);
     mInstance->mAccountSettingsModel = new AccountSettingsModel(mInstance);
 
+    new SoundFilesCache(mInstance);
+
     mInstance->mStarted = true;
 
+    QTimer::singleShot(THUMBNAILS_GC_DELAY, mInstance, &CoreManager::collectThumbnailsOrphans);
+
     emit mInstance->coreStarted();
   });
 
@@ -129,6 +147,11 @@ void CoreManager::init (QObject *parent, const QString &configPath) {
   QObject::connect(timer, &QTimer::timeout, mInstance, &CoreManager::iterate);
 }
 
+CoreManager::~CoreManager () {
+  // The thumbnails store is a static, it must not be used during its destruction.
+  mThumbnailsCollection.waitForFinished();
+}
+
 void CoreManager::uninit () {
   if (mInstance) {
     delete mInstance;
@@ -250,6 +273,56 @@ void CoreManager::iterate () {
 
 // -----------------------------------------------------------------------------
 
+void CoreManager::collectThumbnailsOrphans () {
+  #ifdef SQL_ENABLED
+    // The history API of the core is offset based and must be used in the main
+    // thread. The file ids are read from the database instead, in one query and
+    // in background, with a read only connection.
+    const QString databasePath = ::Utils::coreStringToAppString(Paths::getMessageHistoryFilePath());
+    ThumbnailStore *store = ThumbnailStore::getInstance();
+
+    // Thumbnails created after this snapshot are not collected.
+    const qint64 packSize = store->getPackSize();
+
+    mThumbnailsCollection = QtConcurrent::run([databasePath, store, packSize] {
+      QSet<QString> keys;
+      bool soFarSoGood;
+
+      {
+        QSqlDatabase database = QSqlDatabase::addDatabase("QSQLITE", THUMBNAILS_GC_CONNECTION_NAME);
+        database.setDatabaseName(databasePath);
+        database.setConnectOptions("QSQLITE_OPEN_READONLY;QSQLITE_BUSY_TIMEOUT=" + QString::number(THUMBNAILS_GC_BUSY_TIMEOUT));
+
+        QSqlQuery query(database);
+        query.setForwardOnly(true);
+        soFarSoGood = database.open() && query.exec(
+          "SELECT appdata FROM history WHERE appdata IS NOT NULL AND appdata != ''"
+        );
+        while (soFarSoGood && query.next()) {
+          // Appdata: `fileId[:filePath]`.
+          const QString fileId = query.value(0).toString().section(':', 0, 0);
+          if (!fileId.isEmpty())
+            keys << fileId;
+        }
+        soFarSoGood = soFarSoGood && !query.lastError().isValid();
+
+        if (!soFarSoGood)
+          qWarning() << QStringLiteral("Unable to read file ids of messages, thumbnails are not collected: `%1`.")
+            .arg(query.lastError().isValid() ? query.lastError().text() : database.lastError().text());
+      }
+      QSqlDatabase::removeDatabase(THUMBNAILS_GC_CONNECTION_NAME);
+
+      // Never collect with an incomplete set of keys.
+      if (soFarSoGood)
+        store->collectOrphans(keys, packSize);
+    });
+  #else
+    qInfo() << QStringLiteral("Thumbnails are not collected, Qt Sql is not available.");
+  #endif // ifdef SQL_ENABLED
+}
+
+// -----------------------------------------------------------------------------
+
 void CoreManager::handleLogsUploadStateChanged (linphone::CoreLogCollectionUploadState state, const string &info) {
   switch (state) {
     case linphone::CoreLogCollectionUploadStateInProgress:
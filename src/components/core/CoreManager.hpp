@@ -45,7 +45,7 @@ class CoreManager : public QObject {
   Q_PROPERTY(QString downloadUrl READ getDownloadUrl CONSTANT);
 
 public:
-  ~CoreManager () = default;
+  ~CoreManager ();
 
   bool started () const {
     return mStarted;
@@ -148,6 +148,8 @@ private:
 
   void iterate ();
 
+  void collectThumbnailsOrphans ();
+
   void handleLogsUploadStateChanged (linphone::CoreLogCollectionUploadState state, const std::string &info);
 
   static QString getDownloadUrl ();
@@ -170,6 +172,8 @@ private:
   QFuture<void> mPromiseBuild;
   QFutureWatcher<void> mPromiseWatcher;
 
+  QFuture<void> mThumbnailsCollection;
+
   QMutex mMutexVideoRender;
 
   static CoreManager *mInstance;
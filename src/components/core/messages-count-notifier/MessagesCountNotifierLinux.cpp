@@ -32,14 +32,19 @@
 
 #include "MessagesCountNotifierLinux.hpp"
 
-#define ICON_WIDTH 256
-#define ICON_HEIGHT 256
+// Sizes requested by the tray hosts.
+#define ICON_SIZES { 16, 22, 24, 32, 48, 64 }
 
+// Relative to an icon of 256x256.
 #define ICON_COUNTER_BACKGROUND_COLOR "#FF3C31"
 #define ICON_COUNTER_BACKGROUND_RADIUS 100
 #define ICON_COUNTER_BLINK_INTERVAL 1000
 #define ICON_COUNTER_TEXT_COLOR "#FFFBFA"
 #define ICON_COUNTER_TEXT_PIXEL_SIZE 144
+#define ICON_COUNTER_OVERFLOW_TEXT_PIXEL_SIZE 96
+
+// Bigger counts are displayed as "99+", so at most 100 icons are cached.
+#define ICON_COUNTER_MAX 99
 
 // =============================================================================
 
@@ -48,14 +53,16 @@ MessagesCountNotifier::MessagesCountNotifier (QObject *parent) : AbstractMessage
   if (!renderer.isValid())
     qFatal("Invalid SVG Image.");
 
-  QPixmap buf(ICON_WIDTH, ICON_HEIGHT);
-  buf.fill(QColor(Qt::transparent));
+  for (int size : ICON_SIZES) {
+    QPixmap buf(size, size);
+    buf.fill(QColor(Qt::transparent));
 
-  QPainter painter(&buf);
-  renderer.render(&painter);
+    QPainter painter(&buf);
+    renderer.render(&painter);
 
-  mBuf = new QPixmap(buf);
-  mBufWithCounter = new QPixmap();
+    mPixmaps << buf;
+    mIcon.addPixmap(buf);
+  }
 
   mBlinkTimer = new QTimer(this);
   mBlinkTimer->setInterval(ICON_COUNTER_BLINK_INTERVAL);
@@ -67,43 +74,20 @@ MessagesCountNotifier::MessagesCountNotifier (QObject *parent) : AbstractMessage
   );
 }
 
-MessagesCountNotifier::~MessagesCountNotifier () {
-  delete mBuf;
-  delete mBufWithCounter;
-}
-
 void MessagesCountNotifier::notifyUnreadMessagesCount (int n) {
   QSystemTrayIcon *sysTrayIcon = App::getInstance()->getSystemTrayIcon();
-  if (!sysTrayIcon)
+  if (!sysTrayIcon || n == mCount)
     return;
 
+  mCount = n;
+
   if (!n) {
     mBlinkTimer->stop();
-    sysTrayIcon->setIcon(QIcon(*mBuf));
+    sysTrayIcon->setIcon(mIcon);
     return;
   }
 
-  *mBufWithCounter = *mBuf;
-  QPainter p(mBufWithCounter);
-
-  const int width = mBufWithCounter->width();
-  const int height = mBufWithCounter->height();
-
-  // Draw background.
-  {
-    p.setBrush(QColor(ICON_COUNTER_BACKGROUND_COLOR));
-    p.drawEllipse(QPointF(width / 2, height / 2), ICON_COUNTER_BACKGROUND_RADIUS, ICON_COUNTER_BACKGROUND_RADIUS);
-  }
-
-  // Draw text.
-  {
-    QFont font = p.font();
-    font.setPixelSize(ICON_COUNTER_TEXT_PIXEL_SIZE);
-
-    p.setFont(font);
-    p.setPen(QPen(QColor(ICON_COUNTER_TEXT_COLOR), 1));
-    p.drawText(QRect(0, 0, width, height), Qt::AlignCenter, QString::number(n));
-  }
+  mCounterIcon = getCounterIcon(n);
 
   // Change counter.
   mBlinkTimer->stop();
@@ -112,9 +96,60 @@ void MessagesCountNotifier::notifyUnreadMessagesCount (int n) {
   update();
 }
 
+// Icons are rendered once per count. (1-99, then 99+)
+const QIcon &MessagesCountNotifier::getCounterIcon (int n) {
+  n = qMin(n, ICON_COUNTER_MAX + 1);
+
+  auto it = mCounterIcons.find(n);
+  if (it != mCounterIcons.end())
+    return *it;
+
+  QIcon icon;
+  for (const auto &pixmap : mPixmaps) {
+    QPixmap buf(pixmap);
+    QPainter p(&buf);
+    p.setRenderHint(QPainter::Antialiasing);
+    p.setRenderHint(QPainter::TextAntialiasing);
+
+    const int width = buf.width();
+    const int height = buf.height();
+    const qreal ratio = qreal(width) / 256;
+
+    // Draw background.
+    {
+      const qreal radius = ICON_COUNTER_BACKGROUND_RADIUS * ratio;
+      p.setPen(Qt::NoPen);
+      p.setBrush(QColor(ICON_COUNTER_BACKGROUND_COLOR));
+      p.drawEllipse(QPointF(width / 2.0, height / 2.0), radius, radius);
+    }
+
+    // Draw text.
+    {
+      const bool overflow = n > ICON_COUNTER_MAX;
+
+      QFont font = p.font();
+      font.setPixelSize(qMax(1, qRound(
+        (overflow ? ICON_COUNTER_OVERFLOW_TEXT_PIXEL_SIZE : ICON_COUNTER_TEXT_PIXEL_SIZE) * ratio
+      )));
+
+      p.setFont(font);
+      p.setPen(QPen(QColor(ICON_COUNTER_TEXT_COLOR), 1));
+      p.drawText(
+        QRect(0, 0, width, height), Qt::AlignCenter,
+        overflow ? QStringLiteral("%1+").arg(ICON_COUNTER_MAX) : QString::number(n)
+      );
+    }
+
+    p.end();
+    icon.addPixmap(buf);
+  }
+
+  return *mCounterIcons.insert(n, icon);
+}
+
 void MessagesCountNotifier::update () {
   QSystemTrayIcon *sysTrayIcon = App::getInstance()->getSystemTrayIcon();
   Q_CHECK_PTR(sysTrayIcon);
-  sysTrayIcon->setIcon(QIcon(mDisplayCounter ? *mBufWithCounter : *mBuf));
+  sysTrayIcon->setIcon(mDisplayCounter ? mCounterIcon : mIcon);
   mDisplayCounter = !mDisplayCounter;
 }
@@ -20,6 +20,9 @@
  *      Author: Ronan Abhamon
  */
 
+#include <QHash>
+#include <QIcon>
+
 #include "AbstractMessagesCountNotifier.hpp"
 
 // =============================================================================
@@ -29,7 +32,7 @@ class QTimer;
 class MessagesCountNotifier : public AbstractMessagesCountNotifier {
 public:
   MessagesCountNotifier (QObject *parent = Q_NULLPTR);
-  ~MessagesCountNotifier ();
+  ~MessagesCountNotifier () = default;
 
 protected:
   void notifyUnreadMessagesCount (int n) override;
@@ -37,8 +40,15 @@ protected:
 private:
   void update ();
 
-  const QPixmap *mBuf = nullptr;
-  QPixmap *mBufWithCounter = nullptr;
+  const QIcon &getCounterIcon (int n);
+
+  QList<QPixmap> mPixmaps; // Window icon, one per tray size.
+  QIcon mIcon;
+  QIcon mCounterIcon;
+  QHash<int, QIcon> mCounterIcons;
+
+  int mCount = -1;
+
   QTimer *mBlinkTimer = nullptr;
   bool mDisplayCounter = false;
 };
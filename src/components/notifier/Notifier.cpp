@@ -20,6 +20,7 @@
  *      Author: Ronan Abhamon
  */
 
+#include <QElapsedTimer>
 #include <QQmlComponent>
 #include <QScreen>
 #include <QTimer>
@@ -37,6 +38,7 @@
 // -----------------------------------------------------------------------------
 
 #define NOTIFICATION_SHOW_METHOD_NAME "open"
+#define NOTIFICATION_HIDE_METHOD_NAME "close"
 
 #define NOTIFICATION_PROPERTY_DATA "notificationData"
 
@@ -47,6 +49,10 @@
 
 #define NOTIFICATION_PROPERTY_TIMER "__timer"
 
+#define NOTIFICATION_PROPERTY_TYPE "__type"
+#define NOTIFICATION_PROPERTY_MESSAGES_COUNT "__messagesCount"
+#define NOTIFICATION_PROPERTY_REQUEST_TIME "__requestTime"
+
 // -----------------------------------------------------------------------------
 // Arbitrary hardcoded values.
 // -----------------------------------------------------------------------------
@@ -55,6 +61,12 @@
 #define N_MAX_NOTIFICATIONS 5
 #define MAX_TIMEOUT 30000
 
+// Hidden instances kept for reuse, per type.
+#define MAX_POOLED_NOTIFICATIONS 2
+
+// Received messages are displayed after this delay, grouped by peer. (In ms.)
+#define PENDING_MESSAGES_DELAY 500
+
 using namespace std;
 
 // =============================================================================
@@ -67,6 +79,14 @@ void setProperty (QObject &object, const char *property, const T &value) {
   }
 }
 
+// Monotonic time in ms, used to measure the time to display a notification.
+static inline qint64 getTime () {
+  static QElapsedTimer timer;
+  if (!timer.isValid())
+    timer.start();
+  return timer.elapsed();
+}
+
 // =============================================================================
 // Available notifications.
 // =============================================================================
@@ -97,11 +117,21 @@ Notifier::Notifier (QObject *parent) : QObject(parent) {
   }
 
   mMutex = new QMutex();
+
+  mPendingMessagesTimer = new QTimer(this);
+  mPendingMessagesTimer->setInterval(PENDING_MESSAGES_DELAY);
+  mPendingMessagesTimer->setSingleShot(true);
+  QObject::connect(mPendingMessagesTimer, &QTimer::timeout, this, &Notifier::showPendingMessages);
+
+  QTimer::singleShot(0, this, &Notifier::warmUp);
 }
 
 Notifier::~Notifier () {
   delete mMutex;
 
+  for (const auto &pool : mPools)
+    qDeleteAll(pool);
+
   const int nComponents = mNotifications.size();
   for (int i = 0; i < nComponents; ++i)
     delete mComponents[i];
@@ -122,9 +152,22 @@ QObject *Notifier::createNotification (Notifier::NotificationType type) {
     return nullptr;
   }
 
-  // Create instance and set attributes.
-  QObject *instance = mComponents[type]->create();
-  qInfo() << QStringLiteral("Create notification:") << instance;
+  // Reuse a hidden instance or create a new one, then set attributes.
+  QObject *instance;
+  QList<QObject *> &pool = mPools[type];
+  if (!pool.isEmpty()) {
+    instance = pool.takeLast();
+    instance->setProperty("__valid", QVariant());
+    qInfo() << QStringLiteral("Reuse notification:") << instance;
+  } else {
+    instance = mComponents[type]->create();
+    instance->setProperty(NOTIFICATION_PROPERTY_TYPE, type);
+    qInfo() << QStringLiteral("Create notification:") << instance;
+
+    // Called explicitly (by a click on notification for example)
+    QObject::connect(instance, SIGNAL(deleteNotification(QVariant)), this, SLOT(deleteNotification(QVariant)));
+  }
+  instance->setProperty(NOTIFICATION_PROPERTY_REQUEST_TIME, ::getTime());
 
   mInstancesNumber++;
 
@@ -158,6 +201,17 @@ QObject *Notifier::createNotification (Notifier::NotificationType type) {
 // -----------------------------------------------------------------------------
 
 void Notifier::showNotification (QObject *notification, int timeout) {
+  // Log the time between the request and the first displayed frame.
+  {
+    QQuickWindow *window = notification->findChild<QQuickWindow *>(NOTIFICATION_PROPERTY_WINDOW);
+    Q_CHECK_PTR(window);
+
+    const qint64 requestTime = notification->property(NOTIFICATION_PROPERTY_REQUEST_TIME).toLongLong();
+    ::Utils::connectOnce(window, &QQuickWindow::frameSwapped, this, [notification, requestTime] {
+      qInfo() << QStringLiteral("Notification visible in %1ms:").arg(::getTime() - requestTime) << notification;
+    });
+  }
+
   // Display notification.
   QMetaObject::invokeMethod(notification, NOTIFICATION_SHOW_METHOD_NAME, Qt::DirectConnection);
 
@@ -171,14 +225,24 @@ void Notifier::showNotification (QObject *notification, int timeout) {
       deleteNotification(QVariant::fromValue(notification));
     });
 
-  // Called explicitly (by a click on notification for example)
-  QObject::connect(notification, SIGNAL(deleteNotification(QVariant)), this, SLOT(deleteNotification(QVariant)));
-
   timer->start();
 }
 
 // -----------------------------------------------------------------------------
 
+void Notifier::warmUp () {
+  for (NotificationType type : { ReceivedCall, ReceivedMessage }) {
+    QObject *instance = mComponents[type]->create();
+    instance->setProperty(NOTIFICATION_PROPERTY_TYPE, type);
+    QObject::connect(instance, SIGNAL(deleteNotification(QVariant)), this, SLOT(deleteNotification(QVariant)));
+
+    QMutexLocker locker(mMutex);
+    mPools[type] << instance;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
 void Notifier::deleteNotification (QVariant notification) {
   mMutex->lock();
 
@@ -193,7 +257,10 @@ void Notifier::deleteNotification (QVariant notification) {
   qInfo() << QStringLiteral("Delete notification:") << instance;
 
   instance->setProperty("__valid", true);
-  instance->property(NOTIFICATION_PROPERTY_TIMER).value<QTimer *>()->stop();
+
+  // The timer is the context of the connections specific to this display.
+  instance->property(NOTIFICATION_PROPERTY_TIMER).value<QTimer *>()->deleteLater();
+  instance->setProperty(NOTIFICATION_PROPERTY_TIMER, QVariant());
 
   mInstancesNumber--;
   Q_ASSERT(mInstancesNumber >= 0);
@@ -201,6 +268,26 @@ void Notifier::deleteNotification (QVariant notification) {
   if (mInstancesNumber == 0)
     mOffset = 0;
 
+  const int type = instance->property(NOTIFICATION_PROPERTY_TYPE).toInt();
+  if (type == ReceivedMessage) {
+    mMessageNotifications.remove(mMessageNotifications.key(instance));
+
+    // A place is available for the messages not yet displayed.
+    if (!mPendingSipAddresses.isEmpty() && !mPendingMessagesTimer->isActive())
+      mPendingMessagesTimer->start();
+  }
+
+  // Hide it and keep it for the next notification of the same type.
+  QList<QObject *> &pool = mPools[type];
+  if (pool.count() < MAX_POOLED_NOTIFICATIONS) {
+    pool << instance;
+    mMutex->unlock();
+
+    QMetaObject::invokeMethod(instance, NOTIFICATION_HIDE_METHOD_NAME, Qt::DirectConnection);
+    ::setProperty(*instance, NOTIFICATION_PROPERTY_DATA, QVariantMap());
+    return;
+  }
+
   mMutex->unlock();
 
   instance->deleteLater();
@@ -223,17 +310,18 @@ void Notifier::deleteNotification (QVariant notification) {
 // -----------------------------------------------------------------------------
 
 void Notifier::notifyReceivedMessage (const shared_ptr<linphone::ChatMessage> &message) {
-  CREATE_NOTIFICATION(Notifier::ReceivedMessage);
+  const QString sipAddress = ::Utils::coreStringToAppString(message->getFromAddress()->asStringUriOnly());
 
-  QVariantMap map;
-  map["message"] = message->getFileTransferInformation()
+  PendingMessages &pendingMessages = mPendingMessages[sipAddress];
+  if (pendingMessages.count++ == 0)
+    mPendingSipAddresses << sipAddress;
+
+  pendingMessages.lastMessage = message->getFileTransferInformation()
     ? tr("newFileMessage")
     : ::Utils::coreStringToAppString(message->getText());
 
-  map["sipAddress"] = ::Utils::coreStringToAppString(message->getFromAddress()->asStringUriOnly());
-  map["window"].setValue(App::getInstance()->getMainWindow());
-
-  SHOW_NOTIFICATION(map);
+  if (!mPendingMessagesTimer->isActive())
+    mPendingMessagesTimer->start();
 }
 
 void Notifier::notifyReceivedFileMessage (const shared_ptr<linphone::ChatMessage> &message) {
@@ -251,15 +339,17 @@ void Notifier::notifyReceivedCall (const shared_ptr<linphone::Call> &call) {
 
   CallModel *callModel = &call->getData<CallModel>("call-model");
 
-  QObject::connect(callModel, &CallModel::statusChanged, notification, [this, notification](CallModel::CallStatus status) {
-      if (status == CallModel::CallStatusEnded || status == CallModel::CallStatusConnected)
-        deleteNotification(QVariant::fromValue(notification));
-    });
-
   QVariantMap map;
   map["call"].setValue(callModel);
 
   SHOW_NOTIFICATION(map);
+
+  // Bound to the display timer: the notification instance can be reused.
+  QTimer *timer = notification->property(NOTIFICATION_PROPERTY_TIMER).value<QTimer *>();
+  QObject::connect(callModel, &CallModel::statusChanged, timer, [this, notification](CallModel::CallStatus status) {
+      if (status == CallModel::CallStatusEnded || status == CallModel::CallStatusConnected)
+        deleteNotification(QVariant::fromValue(notification));
+    });
 }
 
 void Notifier::notifyNewVersionAvailable (const QString &version, const QString &url) {
@@ -292,3 +382,44 @@ void Notifier::notifyRecordingCompleted (const QString &filePath) {
 
 #undef SHOW_NOTIFICATION
 #undef CREATE_NOTIFICATION
+
+// -----------------------------------------------------------------------------
+
+void Notifier::showPendingMessages () {
+  const int timeout = mNotifications[ReceivedMessage].timeout * 1000;
+
+  while (!mPendingSipAddresses.isEmpty()) {
+    const QString sipAddress = mPendingSipAddresses.first();
+    const PendingMessages pendingMessages = mPendingMessages.value(sipAddress);
+
+    QObject *notification = mMessageNotifications.value(sipAddress);
+    const bool isNew = !notification;
+    if (isNew) {
+      notification = createNotification(ReceivedMessage);
+
+      // Too many notifications, retried when one is closed.
+      if (!notification)
+        return;
+
+      mMessageNotifications[sipAddress] = notification;
+      notification->setProperty(NOTIFICATION_PROPERTY_MESSAGES_COUNT, 0);
+    }
+
+    mPendingSipAddresses.removeFirst();
+    mPendingMessages.remove(sipAddress);
+
+    const int count = notification->property(NOTIFICATION_PROPERTY_MESSAGES_COUNT).toInt() + pendingMessages.count;
+    notification->setProperty(NOTIFICATION_PROPERTY_MESSAGES_COUNT, count);
+
+    QVariantMap map;
+    map["message"] = count == 1 ? pendingMessages.lastMessage : tr("newMessages").arg(count);
+    map["sipAddress"] = sipAddress;
+    map["window"].setValue(App::getInstance()->getMainWindow());
+
+    ::setProperty(*notification, NOTIFICATION_PROPERTY_DATA, map);
+    if (isNew)
+      showNotification(notification, timeout);
+    else
+      notification->property(NOTIFICATION_PROPERTY_TIMER).value<QTimer *>()->start();
+  }
+}
@@ -24,12 +24,15 @@
 #define NOTIFIER_H_
 
 #include <linphone++/linphone.hh>
+#include <QHash>
 #include <QObject>
+#include <QStringList>
 
 // =============================================================================
 
 class QMutex;
 class QQmlComponent;
+class QTimer;
 
 class Notifier : public QObject {
   Q_OBJECT;
@@ -68,15 +71,37 @@ private:
     int timeout;
   };
 
+  // Received messages not yet displayed, for one peer.
+  struct PendingMessages {
+    int count = 0;
+    QString lastMessage;
+  };
+
   QObject *createNotification (NotificationType type);
   void showNotification (QObject *notification, int timeout);
 
+  // Pre-creates hidden instances of the notifications which must be displayed quickly.
+  void warmUp ();
+
+  // Displays the pending messages, one notification per peer. The messages of a peer
+  // already notified are merged in its notification.
+  void showPendingMessages ();
+
   int mOffset = 0;
   int mInstancesNumber = 0;
 
   QMutex *mMutex = nullptr;
   QQmlComponent **mComponents = nullptr;
 
+  // Hidden instances, reused by `createNotification`.
+  QHash<int, QList<QObject *> > mPools;
+
+  // Received messages are grouped by peer during a short delay.
+  QTimer *mPendingMessagesTimer = nullptr;
+  QStringList mPendingSipAddresses;
+  QHash<QString, PendingMessages> mPendingMessages;
+  QHash<QString, QObject *> mMessageNotifications;
+
   static const QHash<int, Notification> mNotifications;
 };
 
@@ -36,6 +36,10 @@ using namespace std;
 
 // =============================================================================
 
+QAtomicInt Colors::mGeneration;
+
+// -----------------------------------------------------------------------------
+
 #if LINPHONE_FRIDAY
 
   static inline bool isLinphoneFriday () {
@@ -24,6 +24,7 @@
 #define COLORS_H_
 
 #include <linphone++/linphone.hh>
+#include <QAtomicInt>
 #include <QColor>
 #include <QObject>
 
@@ -33,6 +34,7 @@
   Q_PROPERTY(QColor COLOR MEMBER m ## COLOR WRITE set ## COLOR NOTIFY colorT ## COLOR ## Changed); \
   void set ## COLOR(const QColor &color) { \
     m ## COLOR = color; \
+    mGeneration.ref(); \
     emit colorT ## COLOR ## Changed(m ## COLOR); \
   } \
   QColor m ## COLOR = VALUE;
@@ -101,6 +103,12 @@ public:
 
   void useConfig (const std::shared_ptr<linphone::Config> &config);
 
+  // Incremented each time a color is changed. Used to invalidate
+  // caches of recolored images.
+  static int getGeneration () {
+    return mGeneration.load();
+  }
+
 signals:
   void colorTaChanged (const QColor &color);
   void colorTbChanged (const QColor &color);
@@ -135,6 +143,8 @@ private:
   void overrideColors (const std::shared_ptr<linphone::Config> &config);
 
   QStringList getColorNames () const;
+
+  static QAtomicInt mGeneration;
 };
 
 // -----------------------------------------------------------------------------
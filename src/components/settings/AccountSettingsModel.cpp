@@ -20,6 +20,8 @@
  *      Author: Ronan Abhamon
  */
 
+#include <QMetaEnum>
+
 #include "../../app/paths/Paths.hpp"
 #include "../../utils/Utils.hpp"
 #include "../core/CoreManager.hpp"
@@ -176,11 +178,13 @@ bool AccountSettingsModel::addOrUpdateProxyConfig (
 }
 
 shared_ptr<linphone::ProxyConfig> AccountSettingsModel::createProxyConfig () {
-  shared_ptr<linphone::Core> core = CoreManager::getInstance()->getCore();
+  CoreManager *coreManager = CoreManager::getInstance();
+  shared_ptr<linphone::Core> core = coreManager->getCore();
 
   core->getConfig()->loadFromXmlFile(
     Paths::getAssistantConfigDirPath() + "create-linphone-sip-account.rc"
   );
+  coreManager->getSettingsModel()->reloadSnapshot();
 
   return core->createProxyConfig();
 }
@@ -234,6 +238,31 @@ AccountSettingsModel::RegistrationState AccountSettingsModel::getRegistrationSta
   return proxyConfig ? ::mapLinphoneRegistrationStateToUi(proxyConfig->getState()) : RegistrationStateNotRegistered;
 }
 
+QVariantMap AccountSettingsModel::getRegistrationDescription () const {
+  shared_ptr<linphone::Core> core = CoreManager::getInstance()->getCore();
+  shared_ptr<linphone::ProxyConfig> defaultProxyConfig = core->getDefaultProxyConfig();
+  const QMetaEnum registrationStates = QMetaEnum::fromType<RegistrationState>();
+
+  QVariantList proxyConfigs;
+  for (const auto &proxyConfig : core->getProxyConfigList()) {
+    QVariantMap map;
+    const shared_ptr<const linphone::Address> address = proxyConfig->getIdentityAddress();
+    map["sipAddress"] = address
+      ? ::Utils::coreStringToAppString(address->asStringUriOnly())
+      : QString("");
+    map["registrationState"] = QString::fromLatin1(
+      registrationStates.valueToKey(::mapLinphoneRegistrationStateToUi(proxyConfig->getState()))
+    );
+    map["isDefault"] = proxyConfig == defaultProxyConfig;
+    proxyConfigs << map;
+  }
+
+  QVariantMap description;
+  description["registrationState"] = QString::fromLatin1(registrationStates.valueToKey(getRegistrationState()));
+  description["proxyConfigs"] = proxyConfigs;
+  return description;
+}
+
 // -----------------------------------------------------------------------------
 
 QString AccountSettingsModel::getPrimaryUsername () const {
@@ -74,6 +74,10 @@ public:
 
   Q_INVOKABLE void eraseAllPasswords ();
 
+  // Registration state of the default proxy config and of each proxy config,
+  // not translated. Used by the CLI queries.
+  QVariantMap getRegistrationDescription () const;
+
 signals:
   void accountSettingsUpdated ();
 
@@ -0,0 +1,164 @@
+/*
+ * DevicesRegistry.cpp
+ * Copyright (C) 2026  Belledonne Communications, Grenoble, France
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *  Created on: October 17, 2026
+ */
+
+#include <QDir>
+#include <QFileSystemWatcher>
+#include <QTimer>
+
+#include "../../utils/Utils.hpp"
+#include "../core/CoreManager.hpp"
+
+#include "DevicesRegistry.hpp"
+
+// Wait for the end of a burst of device nodes events before reloading.
+#define RELOAD_DELAY 500
+
+// Not a replacement of udev or of the sound server events: a Bluetooth or
+// network sink has no node in this directory.
+#define SOUND_DEVICES_DIR "/dev/snd"
+#define VIDEO_DEVICES_DIR "/dev"
+
+using namespace std;
+
+// =============================================================================
+
+static QStringList getVideoNodes () {
+  return QDir(VIDEO_DEVICES_DIR).entryList(
+    QStringList("video*"), QDir::System | QDir::NoDotAndDotDot, QDir::Name
+  );
+}
+
+static bool updateDevices (QStringList &devices, const QStringList &newDevices) {
+  if (devices == newDevices)
+    return false;
+
+  for (const auto &device : newDevices)
+    if (!devices.contains(device))
+      qInfo() << QStringLiteral("Device plugged: `%1`.").arg(device);
+
+  for (const auto &device : devices)
+    if (!newDevices.contains(device))
+      qInfo() << QStringLiteral("Device unplugged: `%1`.").arg(device);
+
+  devices = newDevices;
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+
+DevicesRegistry::DevicesRegistry (QObject *parent) : QObject(parent) {
+  updateSoundDevices();
+  updateVideoDevices();
+
+  #ifdef Q_OS_LINUX
+    mReloadTimer = new QTimer(this);
+    mReloadTimer->setInterval(RELOAD_DELAY);
+    mReloadTimer->setSingleShot(true);
+    QObject::connect(mReloadTimer, &QTimer::timeout, this, &DevicesRegistry::reload);
+
+    mVideoNodes = ::getVideoNodes();
+
+    QFileSystemWatcher *watcher = new QFileSystemWatcher(this);
+    for (const auto &path : { QStringLiteral(SOUND_DEVICES_DIR), QStringLiteral(VIDEO_DEVICES_DIR) })
+      if (QDir(path).exists() && !watcher->addPath(path))
+        qWarning() << QStringLiteral("Unable to watch devices directory: `%1`.").arg(path);
+
+    QObject::connect(
+      watcher, &QFileSystemWatcher::directoryChanged,
+      this, &DevicesRegistry::handleDirectoryChanged
+    );
+  #endif // ifdef Q_OS_LINUX
+}
+
+// -----------------------------------------------------------------------------
+
+void DevicesRegistry::updateSoundDevices () {
+  shared_ptr<linphone::Core> core = CoreManager::getInstance()->getCore();
+
+  QStringList captureDevices;
+  QStringList playbackDevices;
+
+  for (const auto &device : core->getSoundDevices()) {
+    const QString name = ::Utils::coreStringToAppString(device);
+    if (core->soundDeviceCanCapture(device))
+      captureDevices << name;
+    if (core->soundDeviceCanPlayback(device))
+      playbackDevices << name;
+  }
+
+  // Evaluate both, the two lists must be updated.
+  const bool captureDevicesChanged = ::updateDevices(mCaptureDevices, captureDevices);
+  const bool playbackDevicesChanged = ::updateDevices(mPlaybackDevices, playbackDevices);
+  if (captureDevicesChanged || playbackDevicesChanged)
+    emit soundDevicesChanged();
+}
+
+void DevicesRegistry::updateVideoDevices () {
+  QStringList videoDevices;
+  for (const auto &device : CoreManager::getInstance()->getCore()->getVideoDevices())
+    videoDevices << ::Utils::coreStringToAppString(device);
+
+  if (::updateDevices(mVideoDevices, videoDevices))
+    emit videoDevicesChanged();
+}
+
+// -----------------------------------------------------------------------------
+
+void DevicesRegistry::reload () {
+  shared_ptr<linphone::Core> core = CoreManager::getInstance()->getCore();
+
+  if (mSoundDevicesOutdated) {
+    mSoundDevicesOutdated = false;
+    core->reloadSoundDevices();
+    updateSoundDevices();
+  }
+
+  if (mVideoDevicesOutdated) {
+    mVideoDevicesOutdated = false;
+    core->reloadVideoDevices();
+    updateVideoDevices();
+  }
+}
+
+void DevicesRegistry::handleDirectoryChanged (const QString &path) {
+  if (path == QStringLiteral(SOUND_DEVICES_DIR)) {
+    mSoundDevicesOutdated = true;
+  } else {
+    // The devices directory is noisy, reload only if a video node is added or removed.
+    const QStringList videoNodes = ::getVideoNodes();
+    if (videoNodes != mVideoNodes) {
+      mVideoNodes = videoNodes;
+      mVideoDevicesOutdated = true;
+    }
+
+    // The sound directory is created with the first sound card.
+    QFileSystemWatcher *watcher = static_cast<QFileSystemWatcher *>(sender());
+    if (
+      !watcher->directories().contains(QStringLiteral(SOUND_DEVICES_DIR)) &&
+      QDir(QStringLiteral(SOUND_DEVICES_DIR)).exists() &&
+      watcher->addPath(QStringLiteral(SOUND_DEVICES_DIR))
+    )
+      mSoundDevicesOutdated = true;
+  }
+
+  if (mSoundDevicesOutdated || mVideoDevicesOutdated)
+    mReloadTimer->start();
+}
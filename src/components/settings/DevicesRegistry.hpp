@@ -0,0 +1,80 @@
+/*
+ * DevicesRegistry.hpp
+ * Copyright (C) 2026  Belledonne Communications, Grenoble, France
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *  Created on: October 17, 2026
+ */
+
+#ifndef DEVICES_REGISTRY_H_
+#define DEVICES_REGISTRY_H_
+
+#include <QObject>
+#include <QStringList>
+
+// =============================================================================
+
+class QTimer;
+
+// Keeps the sound and video devices known by the core, so they are not
+// enumerated on each read. On Linux, the device nodes are watched and the
+// devices are reloaded when one is plugged or unplugged.
+// Only ALSA cards and V4L2 devices have a node: the sinks and sources created
+// by a sound server (PulseAudio, PipeWire), like Bluetooth or network devices,
+// are not detected until the next reload.
+class DevicesRegistry : public QObject {
+  Q_OBJECT;
+
+public:
+  DevicesRegistry (QObject *parent = Q_NULLPTR);
+
+  QStringList getCaptureDevices () const {
+    return mCaptureDevices;
+  }
+
+  QStringList getPlaybackDevices () const {
+    return mPlaybackDevices;
+  }
+
+  QStringList getVideoDevices () const {
+    return mVideoDevices;
+  }
+
+signals:
+  void soundDevicesChanged ();
+  void videoDevicesChanged ();
+
+private:
+  void updateSoundDevices ();
+  void updateVideoDevices ();
+
+  void reload ();
+
+  void handleDirectoryChanged (const QString &path);
+
+  QStringList mCaptureDevices;
+  QStringList mPlaybackDevices;
+  QStringList mVideoDevices;
+
+  QStringList mVideoNodes;
+
+  bool mSoundDevicesOutdated = false;
+  bool mVideoDevicesOutdated = false;
+
+  QTimer *mReloadTimer = nullptr;
+};
+
+#endif // DEVICES_REGISTRY_H_
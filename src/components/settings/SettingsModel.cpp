@@ -27,6 +27,7 @@
 #include "../../utils/Utils.hpp"
 #include "../core/CoreManager.hpp"
 
+#include "DevicesRegistry.hpp"
 #include "SettingsModel.hpp"
 
 #ifndef DEFAULT_RLS_URI
@@ -41,7 +42,18 @@ const string SettingsModel::UI_SECTION("ui");
 
 SettingsModel::SettingsModel (QObject *parent) : QObject(parent) {
   mConfig = CoreManager::getInstance()->getCore()->getConfig();
+  loadSnapshot();
   configureRlsUri();
+
+  mDevicesRegistry = new DevicesRegistry(this);
+  QObject::connect(
+    mDevicesRegistry, &DevicesRegistry::soundDevicesChanged,
+    this, &SettingsModel::handleSoundDevicesChanged
+  );
+  QObject::connect(
+    mDevicesRegistry, &DevicesRegistry::videoDevicesChanged,
+    this, &SettingsModel::handleVideoDevicesChanged
+  );
 }
 
 // =============================================================================
@@ -49,78 +61,59 @@ SettingsModel::SettingsModel (QObject *parent) : QObject(parent) {
 // =============================================================================
 
 QStringList SettingsModel::getCaptureDevices () const {
-  shared_ptr<linphone::Core> core = CoreManager::getInstance()->getCore();
-  QStringList list;
-
-  for (const auto &device : core->getSoundDevices()) {
-    if (core->soundDeviceCanCapture(device))
-      list << ::Utils::coreStringToAppString(device);
-  }
-
-  return list;
+  return mDevicesRegistry->getCaptureDevices();
 }
 
 QStringList SettingsModel::getPlaybackDevices () const {
-  shared_ptr<linphone::Core> core = CoreManager::getInstance()->getCore();
-  QStringList list;
-
-  for (const auto &device : core->getSoundDevices()) {
-    if (core->soundDeviceCanPlayback(device))
-      list << ::Utils::coreStringToAppString(device);
-  }
-
-  return list;
+  return mDevicesRegistry->getPlaybackDevices();
 }
 
 // -----------------------------------------------------------------------------
 
 QString SettingsModel::getCaptureDevice () const {
-  return ::Utils::coreStringToAppString(
-    CoreManager::getInstance()->getCore()->getCaptureDevice()
-  );
+  return mSnapshot.captureDevice;
 }
 
 void SettingsModel::setCaptureDevice (const QString &device) {
-  CoreManager::getInstance()->getCore()->setCaptureDevice(
-    ::Utils::appStringToCoreString(device)
-  );
+  shared_ptr<linphone::Core> core = CoreManager::getInstance()->getCore();
+  core->setCaptureDevice(::Utils::appStringToCoreString(device));
+  mSnapshot.captureDevice = ::Utils::coreStringToAppString(core->getCaptureDevice());
+
   emit captureDeviceChanged(device);
 }
 
 // -----------------------------------------------------------------------------
 
 QString SettingsModel::getPlaybackDevice () const {
-  return ::Utils::coreStringToAppString(
-    CoreManager::getInstance()->getCore()->getPlaybackDevice()
-  );
+  return mSnapshot.playbackDevice;
 }
 
 void SettingsModel::setPlaybackDevice (const QString &device) {
-  CoreManager::getInstance()->getCore()->setPlaybackDevice(
-    ::Utils::appStringToCoreString(device)
-  );
+  shared_ptr<linphone::Core> core = CoreManager::getInstance()->getCore();
+  core->setPlaybackDevice(::Utils::appStringToCoreString(device));
+  mSnapshot.playbackDevice = ::Utils::coreStringToAppString(core->getPlaybackDevice());
+
   emit playbackDeviceChanged(device);
 }
 
 // -----------------------------------------------------------------------------
 
 QString SettingsModel::getRingerDevice () const {
-  return ::Utils::coreStringToAppString(
-    CoreManager::getInstance()->getCore()->getRingerDevice()
-  );
+  return mSnapshot.ringerDevice;
 }
 
 void SettingsModel::setRingerDevice (const QString &device) {
-  CoreManager::getInstance()->getCore()->setRingerDevice(
-    ::Utils::appStringToCoreString(device)
-  );
+  shared_ptr<linphone::Core> core = CoreManager::getInstance()->getCore();
+  core->setRingerDevice(::Utils::appStringToCoreString(device));
+  mSnapshot.ringerDevice = ::Utils::coreStringToAppString(core->getRingerDevice());
+
   emit ringerDeviceChanged(device);
 }
 
 // -----------------------------------------------------------------------------
 
 QString SettingsModel::getRingPath () const {
-  return ::Utils::coreStringToAppString(CoreManager::getInstance()->getCore()->getRing());
+  return mSnapshot.ringPath;
 }
 
 void SettingsModel::setRingPath (const QString &path) {
@@ -129,6 +122,7 @@ void SettingsModel::setRingPath (const QString &path) {
   CoreManager::getInstance()->getCore()->setRing(
     ::Utils::appStringToCoreString(cleanedPath)
   );
+  mSnapshot.ringPath = cleanedPath;
 
   emit ringPathChanged(cleanedPath);
 }
@@ -136,11 +130,12 @@ void SettingsModel::setRingPath (const QString &path) {
 // -----------------------------------------------------------------------------
 
 bool SettingsModel::getEchoCancellationEnabled () const {
-  return CoreManager::getInstance()->getCore()->echoCancellationEnabled();
+  return mSnapshot.echoCancellationEnabled;
 }
 
 void SettingsModel::setEchoCancellationEnabled (bool status) {
   CoreManager::getInstance()->getCore()->enableEchoCancellation(status);
+  mSnapshot.echoCancellationEnabled = status;
   emit echoCancellationEnabledChanged(status);
 }
 
@@ -149,52 +144,46 @@ void SettingsModel::setEchoCancellationEnabled (bool status) {
 // =============================================================================
 
 QStringList SettingsModel::getVideoDevices () const {
-  QStringList list;
-
-  for (const auto &device : CoreManager::getInstance()->getCore()->getVideoDevices())
-    list << ::Utils::coreStringToAppString(device);
-
-  return list;
+  return mDevicesRegistry->getVideoDevices();
 }
 
 // -----------------------------------------------------------------------------
 
 QString SettingsModel::getVideoDevice () const {
-  return ::Utils::coreStringToAppString(
-    CoreManager::getInstance()->getCore()->getVideoDevice()
-  );
+  return mSnapshot.videoDevice;
 }
 
 void SettingsModel::setVideoDevice (const QString &device) {
-  CoreManager::getInstance()->getCore()->setVideoDevice(
-    ::Utils::appStringToCoreString(device)
-  );
+  shared_ptr<linphone::Core> core = CoreManager::getInstance()->getCore();
+  core->setVideoDevice(::Utils::appStringToCoreString(device));
+  mSnapshot.videoDevice = ::Utils::coreStringToAppString(core->getVideoDevice());
+
   emit videoDeviceChanged(device);
 }
 
 // -----------------------------------------------------------------------------
 
 QString SettingsModel::getVideoPreset () const {
-  return ::Utils::coreStringToAppString(
-    CoreManager::getInstance()->getCore()->getVideoPreset()
-  );
+  return mSnapshot.videoPreset;
 }
 
 void SettingsModel::setVideoPreset (const QString &preset) {
-  CoreManager::getInstance()->getCore()->setVideoPreset(
-    ::Utils::appStringToCoreString(preset)
-  );
+  shared_ptr<linphone::Core> core = CoreManager::getInstance()->getCore();
+  core->setVideoPreset(::Utils::appStringToCoreString(preset));
+  mSnapshot.videoPreset = ::Utils::coreStringToAppString(core->getVideoPreset());
+
   emit videoPresetChanged(preset);
 }
 
 // -----------------------------------------------------------------------------
 
 int SettingsModel::getVideoFramerate () const {
-  return static_cast<int>(CoreManager::getInstance()->getCore()->getPreferredFramerate());
+  return mSnapshot.videoFramerate;
 }
 
 void SettingsModel::setVideoFramerate (int framerate) {
   CoreManager::getInstance()->getCore()->setPreferredFramerate(static_cast<float>(framerate));
+  mSnapshot.videoFramerate = framerate;
   emit videoFramerateChanged(framerate);
 }
 
@@ -229,13 +218,15 @@ QVariantList SettingsModel::getSupportedVideoDefinitions () const {
 }
 
 QVariantMap SettingsModel::getVideoDefinition () const {
-  return ::createMapFromVideoDefinition(CoreManager::getInstance()->getCore()->getPreferredVideoDefinition());
+  return mSnapshot.videoDefinition;
 }
 
 void SettingsModel::setVideoDefinition (const QVariantMap &definition) {
-  CoreManager::getInstance()->getCore()->setPreferredVideoDefinition(
+  shared_ptr<linphone::Core> core = CoreManager::getInstance()->getCore();
+  core->setPreferredVideoDefinition(
     definition.value("__definition").value<shared_ptr<const linphone::VideoDefinition> >()->clone()
   );
+  mSnapshot.videoDefinition = ::createMapFromVideoDefinition(core->getPreferredVideoDefinition());
 
   emit videoDefinitionChanged(definition);
 }
@@ -245,48 +236,50 @@ void SettingsModel::setVideoDefinition (const QVariantMap &definition) {
 // =============================================================================
 
 int SettingsModel::getAutoAnswerDelay () const {
-  return mConfig->getInt(UI_SECTION, "auto_answer_delay", 0);
+  return mSnapshot.autoAnswerDelay;
 }
 
 void SettingsModel::setAutoAnswerDelay (int delay) {
   mConfig->setInt(UI_SECTION, "auto_answer_delay", delay);
+  mSnapshot.autoAnswerDelay = delay;
   emit autoAnswerDelayChanged(delay);
 }
 
 // -----------------------------------------------------------------------------
 
 bool SettingsModel::getAutoAnswerStatus () const {
-  return !!mConfig->getInt(UI_SECTION, "auto_answer", 0);
+  return mSnapshot.autoAnswerStatus;
 }
 
 void SettingsModel::setAutoAnswerStatus (bool status) {
   mConfig->setInt(UI_SECTION, "auto_answer", status);
+  mSnapshot.autoAnswerStatus = status;
   emit autoAnswerStatusChanged(status);
 }
 
 // -----------------------------------------------------------------------------
 
 bool SettingsModel::getAutoAnswerVideoStatus () const {
-  return !!mConfig->getInt(UI_SECTION, "auto_answer_with_video", 0);
+  return mSnapshot.autoAnswerVideoStatus;
 }
 
 void SettingsModel::setAutoAnswerVideoStatus (bool status) {
   mConfig->setInt(UI_SECTION, "auto_answer_with_video", status);
+  mSnapshot.autoAnswerVideoStatus = status;
   emit autoAnswerVideoStatusChanged(status);
 }
 
 // -----------------------------------------------------------------------------
 
 QString SettingsModel::getFileTransferUrl () const {
-  return ::Utils::coreStringToAppString(
-    CoreManager::getInstance()->getCore()->getFileTransferServer()
-  );
+  return mSnapshot.fileTransferUrl;
 }
 
 void SettingsModel::setFileTransferUrl (const QString &url) {
   CoreManager::getInstance()->getCore()->setFileTransferServer(
     ::Utils::appStringToCoreString(url)
   );
+  mSnapshot.fileTransferUrl = url;
   emit fileTransferUrlChanged(url);
 }
 
@@ -321,9 +314,7 @@ QVariantList SettingsModel::getSupportedMediaEncryptions () const {
 // -----------------------------------------------------------------------------
 
 SettingsModel::MediaEncryption SettingsModel::getMediaEncryption () const {
-  return static_cast<SettingsModel::MediaEncryption>(
-    CoreManager::getInstance()->getCore()->getMediaEncryption()
-  );
+  return mSnapshot.mediaEncryption;
 }
 
 void SettingsModel::setMediaEncryption (MediaEncryption encryption) {
@@ -336,6 +327,7 @@ void SettingsModel::setMediaEncryption (MediaEncryption encryption) {
   CoreManager::getInstance()->getCore()->setMediaEncryption(
     static_cast<linphone::MediaEncryption>(encryption)
   );
+  mSnapshot.mediaEncryption = encryption;
 
   emit mediaEncryptionChanged(encryption);
 }
@@ -343,9 +335,7 @@ void SettingsModel::setMediaEncryption (MediaEncryption encryption) {
 // -----------------------------------------------------------------------------
 
 SettingsModel::LimeState SettingsModel::getLimeState () const {
-  return static_cast<SettingsModel::LimeState>(
-    CoreManager::getInstance()->getCore()->limeEnabled()
-  );
+  return mSnapshot.limeState;
 }
 
 void SettingsModel::setLimeState (LimeState state) {
@@ -358,6 +348,7 @@ void SettingsModel::setLimeState (LimeState state) {
   CoreManager::getInstance()->getCore()->enableLime(
     static_cast<linphone::LimeState>(state)
   );
+  mSnapshot.limeState = state;
 
   emit limeStateChanged(state);
 }
@@ -367,7 +358,7 @@ void SettingsModel::setLimeState (LimeState state) {
 // =============================================================================
 
 bool SettingsModel::getUseSipInfoForDtmfs () const {
-  return CoreManager::getInstance()->getCore()->getUseInfoForDtmf();
+  return mSnapshot.useSipInfoForDtmfs;
 }
 
 void SettingsModel::setUseSipInfoForDtmfs (bool status) {
@@ -381,13 +372,16 @@ void SettingsModel::setUseSipInfoForDtmfs (bool status) {
     core->setUseRfc2833ForDtmf(true);
   }
 
+  mSnapshot.useSipInfoForDtmfs = core->getUseInfoForDtmf();
+  mSnapshot.useRfc2833ForDtmfs = core->getUseRfc2833ForDtmf();
+
   emit dtmfsProtocolChanged();
 }
 
 // -----------------------------------------------------------------------------
 
 bool SettingsModel::getUseRfc2833ForDtmfs () const {
-  return CoreManager::getInstance()->getCore()->getUseRfc2833ForDtmf();
+  return mSnapshot.useRfc2833ForDtmfs;
 }
 
 void SettingsModel::setUseRfc2833ForDtmfs (bool status) {
@@ -401,57 +395,68 @@ void SettingsModel::setUseRfc2833ForDtmfs (bool status) {
     core->setUseInfoForDtmf(true);
   }
 
+  mSnapshot.useSipInfoForDtmfs = core->getUseInfoForDtmf();
+  mSnapshot.useRfc2833ForDtmfs = core->getUseRfc2833ForDtmf();
+
   emit dtmfsProtocolChanged();
 }
 
 // -----------------------------------------------------------------------------
 
 bool SettingsModel::getIpv6Enabled () const {
-  return CoreManager::getInstance()->getCore()->ipv6Enabled();
+  return mSnapshot.ipv6Enabled;
 }
 
 void SettingsModel::setIpv6Enabled (bool status) {
   CoreManager::getInstance()->getCore()->enableIpv6(status);
+  mSnapshot.ipv6Enabled = status;
   emit ipv6EnabledChanged(status);
 }
 
 // -----------------------------------------------------------------------------
 
 int SettingsModel::getDownloadBandwidth () const {
-  return CoreManager::getInstance()->getCore()->getDownloadBandwidth();
+  return mSnapshot.downloadBandwidth;
 }
 
 void SettingsModel::setDownloadBandwidth (int bandwidth) {
-  CoreManager::getInstance()->getCore()->setDownloadBandwidth(bandwidth);
-  emit downloadBandWidthChanged(getDownloadBandwidth());
+  shared_ptr<linphone::Core> core = CoreManager::getInstance()->getCore();
+  core->setDownloadBandwidth(bandwidth);
+  mSnapshot.downloadBandwidth = core->getDownloadBandwidth();
+
+  emit downloadBandWidthChanged(mSnapshot.downloadBandwidth);
 }
 
 // -----------------------------------------------------------------------------
 
 int SettingsModel::getUploadBandwidth () const {
-  return CoreManager::getInstance()->getCore()->getUploadBandwidth();
+  return mSnapshot.uploadBandwidth;
 }
 
 void SettingsModel::setUploadBandwidth (int bandwidth) {
-  CoreManager::getInstance()->getCore()->setUploadBandwidth(bandwidth);
-  emit uploadBandWidthChanged(getUploadBandwidth());
+  shared_ptr<linphone::Core> core = CoreManager::getInstance()->getCore();
+  core->setUploadBandwidth(bandwidth);
+  mSnapshot.uploadBandwidth = core->getUploadBandwidth();
+
+  emit uploadBandWidthChanged(mSnapshot.uploadBandwidth);
 }
 
 // -----------------------------------------------------------------------------
 
 bool SettingsModel::getAdaptiveRateControlEnabled () const {
-  return CoreManager::getInstance()->getCore()->adaptiveRateControlEnabled();
+  return mSnapshot.adaptiveRateControlEnabled;
 }
 
 void SettingsModel::setAdaptiveRateControlEnabled (bool status) {
   CoreManager::getInstance()->getCore()->enableAdaptiveRateControl(status);
+  mSnapshot.adaptiveRateControlEnabled = status;
   emit adaptiveRateControlEnabledChanged(status);
 }
 
 // -----------------------------------------------------------------------------
 
 int SettingsModel::getTcpPort () const {
-  return CoreManager::getInstance()->getCore()->getTransports()->getTcpPort();
+  return mSnapshot.tcpPort;
 }
 
 void SettingsModel::setTcpPort (int port) {
@@ -460,6 +465,7 @@ void SettingsModel::setTcpPort (int port) {
 
   transports->setTcpPort(port);
   core->setTransports(transports);
+  mSnapshot.tcpPort = core->getTransports()->getTcpPort();
 
   emit tcpPortChanged(port);
 }
@@ -467,7 +473,7 @@ void SettingsModel::setTcpPort (int port) {
 // -----------------------------------------------------------------------------
 
 int SettingsModel::getUdpPort () const {
-  return CoreManager::getInstance()->getCore()->getTransports()->getUdpPort();
+  return mSnapshot.udpPort;
 }
 
 void SettingsModel::setUdpPort (int port) {
@@ -476,6 +482,7 @@ void SettingsModel::setUdpPort (int port) {
 
   transports->setUdpPort(port);
   core->setTransports(transports);
+  mSnapshot.udpPort = core->getTransports()->getUdpPort();
 
   emit udpPortChanged(port);
 }
@@ -483,7 +490,7 @@ void SettingsModel::setUdpPort (int port) {
 // -----------------------------------------------------------------------------
 
 int SettingsModel::getTlsPort () const {
-  return CoreManager::getInstance()->getCore()->getTransports()->getTlsPort();
+  return mSnapshot.tlsPort;
 }
 
 void SettingsModel::setTlsPort (int port) {
@@ -492,6 +499,7 @@ void SettingsModel::setTlsPort (int port) {
 
   transports->setTlsPort(port);
   core->setTransports(transports);
+  mSnapshot.tlsPort = core->getTransports()->getTlsPort();
 
   emit tlsPortChanged(port);
 }
@@ -499,8 +507,7 @@ void SettingsModel::setTlsPort (int port) {
 // -----------------------------------------------------------------------------
 
 QList<int> SettingsModel::getAudioPortRange () const {
-  shared_ptr<linphone::Range> range = CoreManager::getInstance()->getCore()->getAudioPortsRange();
-  return QList<int>() << range->getMin() << range->getMax();
+  return mSnapshot.audioPortRange;
 }
 
 void SettingsModel::setAudioPortRange (const QList<int> &range) {
@@ -513,14 +520,16 @@ void SettingsModel::setAudioPortRange (const QList<int> &range) {
   else
     core->setAudioPortRange(a, b);
 
+  shared_ptr<linphone::Range> portsRange = core->getAudioPortsRange();
+  mSnapshot.audioPortRange = QList<int>() << portsRange->getMin() << portsRange->getMax();
+
   emit audioPortRangeChanged(a, b);
 }
 
 // -----------------------------------------------------------------------------
 
 QList<int> SettingsModel::getVideoPortRange () const {
-  shared_ptr<linphone::Range> range = CoreManager::getInstance()->getCore()->getVideoPortsRange();
-  return QList<int>() << range->getMin() << range->getMax();
+  return mSnapshot.videoPortRange;
 }
 
 void SettingsModel::setVideoPortRange (const QList<int> &range) {
@@ -533,13 +542,16 @@ void SettingsModel::setVideoPortRange (const QList<int> &range) {
   else
     core->setVideoPortRange(a, b);
 
+  shared_ptr<linphone::Range> portsRange = core->getVideoPortsRange();
+  mSnapshot.videoPortRange = QList<int>() << portsRange->getMin() << portsRange->getMax();
+
   emit videoPortRangeChanged(a, b);
 }
 
 // -----------------------------------------------------------------------------
 
 bool SettingsModel::getIceEnabled () const {
-  return CoreManager::getInstance()->getCore()->getNatPolicy()->iceEnabled();
+  return mSnapshot.iceEnabled;
 }
 
 void SettingsModel::setIceEnabled (bool status) {
@@ -547,6 +559,7 @@ void SettingsModel::setIceEnabled (bool status) {
 
   natPolicy->enableIce(status);
   natPolicy->enableStun(status);
+  mSnapshot.iceEnabled = status;
 
   emit iceEnabledChanged(status);
 }
@@ -554,40 +567,39 @@ void SettingsModel::setIceEnabled (bool status) {
 // -----------------------------------------------------------------------------
 
 bool SettingsModel::getTurnEnabled () const {
-  return CoreManager::getInstance()->getCore()->getNatPolicy()->turnEnabled();
+  return mSnapshot.turnEnabled;
 }
 
 void SettingsModel::setTurnEnabled (bool status) {
   CoreManager::getInstance()->getCore()->getNatPolicy()->enableTurn(status);
+  mSnapshot.turnEnabled = status;
   emit turnEnabledChanged(status);
 }
 
 // -----------------------------------------------------------------------------
 
 QString SettingsModel::getStunServer () const {
-  return ::Utils::coreStringToAppString(
-    CoreManager::getInstance()->getCore()->getNatPolicy()->getStunServer()
-  );
+  return mSnapshot.stunServer;
 }
 
 void SettingsModel::setStunServer (const QString &stunServer) {
   CoreManager::getInstance()->getCore()->getNatPolicy()->setStunServer(
     ::Utils::appStringToCoreString(stunServer)
   );
+  mSnapshot.stunServer = stunServer;
 }
 
 // -----------------------------------------------------------------------------
 
 QString SettingsModel::getTurnUser () const {
-  return ::Utils::coreStringToAppString(
-    CoreManager::getInstance()->getCore()->getNatPolicy()->getStunServerUsername()
-  );
+  return mSnapshot.turnUser;
 }
 
 void SettingsModel::setTurnUser (const QString &user) {
   CoreManager::getInstance()->getCore()->getNatPolicy()->setStunServerUsername(
     ::Utils::appStringToCoreString(user)
   );
+  mSnapshot.turnUser = user;
 
   emit turnUserChanged(user);
 }
@@ -626,40 +638,44 @@ void SettingsModel::setTurnPassword (const QString &password) {
 // -----------------------------------------------------------------------------
 
 int SettingsModel::getDscpSip () const {
-  return CoreManager::getInstance()->getCore()->getSipDscp();
+  return mSnapshot.dscpSip;
 }
 
 void SettingsModel::setDscpSip (int dscp) {
   CoreManager::getInstance()->getCore()->setSipDscp(dscp);
+  mSnapshot.dscpSip = dscp;
   emit dscpSipChanged(dscp);
 }
 
 int SettingsModel::getDscpAudio () const {
-  return CoreManager::getInstance()->getCore()->getAudioDscp();
+  return mSnapshot.dscpAudio;
 }
 
 void SettingsModel::setDscpAudio (int dscp) {
   CoreManager::getInstance()->getCore()->setAudioDscp(dscp);
+  mSnapshot.dscpAudio = dscp;
   emit dscpAudioChanged(dscp);
 }
 
 int SettingsModel::getDscpVideo () const {
-  return CoreManager::getInstance()->getCore()->getVideoDscp();
+  return mSnapshot.dscpVideo;
 }
 
 void SettingsModel::setDscpVideo (int dscp) {
   CoreManager::getInstance()->getCore()->setVideoDscp(dscp);
+  mSnapshot.dscpVideo = dscp;
   emit dscpVideoChanged(dscp);
 }
 
 // -----------------------------------------------------------------------------
 
 bool SettingsModel::getRlsUriEnabled () const {
-  return !!mConfig->getInt(UI_SECTION, "rls_uri_enabled", true);
+  return mSnapshot.rlsUriEnabled;
 }
 
 void SettingsModel::setRlsUriEnabled (bool status) {
   mConfig->setInt(UI_SECTION, "rls_uri_enabled", status);
+  mSnapshot.rlsUriEnabled = status;
   mConfig->setString("sip", "rls_uri", status ? DEFAULT_RLS_URI : "");
   emit rlsUriEnabledChanged(status);
 }
@@ -713,75 +729,69 @@ void SettingsModel::configureRlsUri (const shared_ptr<const linphone::ProxyConfi
 // =============================================================================
 
 QString SettingsModel::getSavedScreenshotsFolder () const {
-  return QDir::cleanPath(
-    ::Utils::coreStringToAppString(
-      mConfig->getString(UI_SECTION, "saved_screenshots_folder", Paths::getCapturesDirPath())
-    )
-  ) + QDir::separator();
+  return mSnapshot.savedScreenshotsFolder;
 }
 
 void SettingsModel::setSavedScreenshotsFolder (const QString &folder) {
   QString cleanedFolder = QDir::cleanPath(folder) + QDir::separator();
 
   mConfig->setString(UI_SECTION, "saved_screenshots_folder", ::Utils::appStringToCoreString(cleanedFolder));
+  mSnapshot.savedScreenshotsFolder = cleanedFolder;
   emit savedScreenshotsFolderChanged(cleanedFolder);
 }
 
 // -----------------------------------------------------------------------------
 
 QString SettingsModel::getSavedVideosFolder () const {
-  return QDir::cleanPath(
-    ::Utils::coreStringToAppString(
-      mConfig->getString(UI_SECTION, "saved_videos_folder", Paths::getCapturesDirPath())
-    )
-  ) + QDir::separator();
+  return mSnapshot.savedVideosFolder;
 }
 
 void SettingsModel::setSavedVideosFolder (const QString &folder) {
   QString cleanedFolder = QDir::cleanPath(folder) + QDir::separator();
 
   mConfig->setString(UI_SECTION, "saved_videos_folder", ::Utils::appStringToCoreString(cleanedFolder));
+  mSnapshot.savedVideosFolder = cleanedFolder;
   emit savedVideosFolderChanged(cleanedFolder);
 }
 
 // -----------------------------------------------------------------------------
 
 QString SettingsModel::getDownloadFolder () const {
-  return QDir::cleanPath(
-    ::Utils::coreStringToAppString(
-      mConfig->getString(UI_SECTION, "download_folder", Paths::getDownloadDirPath())
-    )
-  ) + QDir::separator();
+  return mSnapshot.downloadFolder;
 }
 
 void SettingsModel::setDownloadFolder (const QString &folder) {
   QString cleanedFolder = QDir::cleanPath(folder) + QDir::separator();
 
   mConfig->setString(UI_SECTION, "download_folder", ::Utils::appStringToCoreString(cleanedFolder));
+  mSnapshot.downloadFolder = cleanedFolder;
   emit downloadFolderChanged(cleanedFolder);
 }
 
 // -----------------------------------------------------------------------------
 
 QString SettingsModel::getRemoteProvisioning () const {
-  return ::Utils::coreStringToAppString(CoreManager::getInstance()->getCore()->getProvisioningUri());
+  return mSnapshot.remoteProvisioning;
 }
 
 void SettingsModel::setRemoteProvisioning (const QString &remoteProvisioning) {
-  if (!CoreManager::getInstance()->getCore()->setProvisioningUri(::Utils::appStringToCoreString(remoteProvisioning)))
+  if (!CoreManager::getInstance()->getCore()->setProvisioningUri(::Utils::appStringToCoreString(remoteProvisioning))) {
+    mSnapshot.remoteProvisioning = remoteProvisioning;
     emit remoteProvisioningChanged(remoteProvisioning);
-  else
+  } else {
     emit remoteProvisioningNotChanged(remoteProvisioning);
+  }
 }
 
 // -----------------------------------------------------------------------------
 
 bool SettingsModel::getExitOnClose () const {
-  return !!mConfig->getInt(UI_SECTION, "exit_on_close", 0);
+  return mSnapshot.exitOnClose;
 }
 
 void SettingsModel::setExitOnClose (bool value) {
   mConfig->setInt(UI_SECTION, "exit_on_close", value);
+  mSnapshot.exitOnClose = value;
   emit exitOnCloseChanged(value);
 }
 
@@ -790,13 +800,14 @@ void SettingsModel::setExitOnClose (bool value) {
 // =============================================================================
 
 QString SettingsModel::getLogsFolder () const {
-  return getLogsFolder(mConfig);
+  return mSnapshot.logsFolder;
 }
 
 void SettingsModel::setLogsFolder (const QString &folder) {
   // Do not update path in linphone core.
   // Just update the config file.
   mConfig->setString(UI_SECTION, "logs_folder", ::Utils::appStringToCoreString(folder));
+  mSnapshot.logsFolder = folder;
 
   emit logsFolderChanged(folder);
 }
@@ -804,27 +815,26 @@ void SettingsModel::setLogsFolder (const QString &folder) {
 // -----------------------------------------------------------------------------
 
 QString SettingsModel::getLogsUploadUrl () const {
-  return ::Utils::coreStringToAppString(
-    CoreManager::getInstance()->getCore()->getLogCollectionUploadServerUrl()
-  );
+  return mSnapshot.logsUploadUrl;
 }
 
 void SettingsModel::setLogsUploadUrl (const QString &url) {
-  CoreManager::getInstance()->getCore()->setLogCollectionUploadServerUrl(
-    ::Utils::appStringToCoreString(url)
-  );
+  shared_ptr<linphone::Core> core = CoreManager::getInstance()->getCore();
+  core->setLogCollectionUploadServerUrl(::Utils::appStringToCoreString(url));
+  mSnapshot.logsUploadUrl = ::Utils::coreStringToAppString(core->getLogCollectionUploadServerUrl());
 
-  emit logsUploadUrlChanged(getLogsUploadUrl());
+  emit logsUploadUrlChanged(mSnapshot.logsUploadUrl);
 }
 
 // -----------------------------------------------------------------------------
 
 bool SettingsModel::getLogsEnabled () const {
-  return getLogsEnabled(mConfig);
+  return mSnapshot.logsEnabled;
 }
 
 void SettingsModel::setLogsEnabled (bool status) {
   mConfig->setInt(UI_SECTION, "logs_enabled", status);
+  mSnapshot.logsEnabled = status;
   Logger::getInstance()->enable(status);
   emit logsEnabledChanged(status);
 }
@@ -832,18 +842,33 @@ void SettingsModel::setLogsEnabled (bool status) {
 // ---------------------------------------------------------------------------
 
 QString SettingsModel::getLogsEmail () const {
-  return ::Utils::coreStringToAppString(
-    mConfig->getString(UI_SECTION, "logs_email", "")
-  );
+  return mSnapshot.logsEmail;
 }
 
 void SettingsModel::setLogsEmail (const QString &email) {
   mConfig->setString(UI_SECTION, "logs_email", ::Utils::appStringToCoreString(email));
+  mSnapshot.logsEmail = email;
   emit logsEmailChanged(email);
 }
 
 // ---------------------------------------------------------------------------
 
+QString SettingsModel::getLogsLevels () const {
+  return mSnapshot.logsLevels;
+}
+
+void SettingsModel::setLogsLevels (const QString &levels) {
+  // Levels are applied immediately, no restart is required.
+  if (Logger::getInstance()->setLogLevels(levels)) {
+    mConfig->setString(UI_SECTION, "logs_levels", ::Utils::appStringToCoreString(levels));
+    mSnapshot.logsLevels = getLogsLevels(mConfig);
+  }
+
+  emit logsLevelsChanged(mSnapshot.logsLevels);
+}
+
+// ---------------------------------------------------------------------------
+
 QString SettingsModel::getLogsFolder (const shared_ptr<linphone::Config> &config) {
   return ::Utils::coreStringToAppString(config
     ? config->getString(UI_SECTION, "logs_folder", Paths::getLogsDirPath())
@@ -853,3 +878,197 @@ QString SettingsModel::getLogsFolder (const shared_ptr<linphone::Config> &config
 bool SettingsModel::getLogsEnabled (const shared_ptr<linphone::Config> &config) {
   return config ? config->getInt(UI_SECTION, "logs_enabled", false) : false;
 }
+
+QString SettingsModel::getLogsLevels (const shared_ptr<linphone::Config> &config) {
+  return config ? ::Utils::coreStringToAppString(config->getString(UI_SECTION, "logs_levels", "")) : QString("");
+}
+
+// =============================================================================
+// Snapshot.
+// =============================================================================
+
+static inline QString getFolder (
+  const shared_ptr<linphone::Config> &config,
+  const string &key,
+  const string &defaultFolder
+) {
+  return QDir::cleanPath(
+    ::Utils::coreStringToAppString(config->getString(SettingsModel::UI_SECTION, key, defaultFolder))
+  ) + QDir::separator();
+}
+
+#define EMIT_IF_CHANGED(FIELD, SIGNAL) \
+  if (mSnapshot.FIELD != previous.FIELD) \
+    emit SIGNAL(mSnapshot.FIELD)
+
+void SettingsModel::reloadSnapshot () {
+  const Snapshot previous = mSnapshot;
+  loadSnapshot();
+
+  // Audio.
+  EMIT_IF_CHANGED(captureDevice, captureDeviceChanged);
+  EMIT_IF_CHANGED(playbackDevice, playbackDeviceChanged);
+  EMIT_IF_CHANGED(ringerDevice, ringerDeviceChanged);
+  EMIT_IF_CHANGED(ringPath, ringPathChanged);
+  EMIT_IF_CHANGED(echoCancellationEnabled, echoCancellationEnabledChanged);
+
+  // Video.
+  EMIT_IF_CHANGED(videoDevice, videoDeviceChanged);
+  EMIT_IF_CHANGED(videoPreset, videoPresetChanged);
+  EMIT_IF_CHANGED(videoFramerate, videoFramerateChanged);
+  EMIT_IF_CHANGED(videoDefinition, videoDefinitionChanged);
+
+  // Chat & calls.
+  EMIT_IF_CHANGED(autoAnswerStatus, autoAnswerStatusChanged);
+  EMIT_IF_CHANGED(autoAnswerVideoStatus, autoAnswerVideoStatusChanged);
+  EMIT_IF_CHANGED(autoAnswerDelay, autoAnswerDelayChanged);
+  EMIT_IF_CHANGED(fileTransferUrl, fileTransferUrlChanged);
+  EMIT_IF_CHANGED(mediaEncryption, mediaEncryptionChanged);
+  EMIT_IF_CHANGED(limeState, limeStateChanged);
+
+  // Network.
+  if (
+    mSnapshot.useSipInfoForDtmfs != previous.useSipInfoForDtmfs ||
+    mSnapshot.useRfc2833ForDtmfs != previous.useRfc2833ForDtmfs
+  )
+    emit dtmfsProtocolChanged();
+  EMIT_IF_CHANGED(ipv6Enabled, ipv6EnabledChanged);
+  EMIT_IF_CHANGED(downloadBandwidth, downloadBandWidthChanged);
+  EMIT_IF_CHANGED(uploadBandwidth, uploadBandWidthChanged);
+  EMIT_IF_CHANGED(adaptiveRateControlEnabled, adaptiveRateControlEnabledChanged);
+  EMIT_IF_CHANGED(tcpPort, tcpPortChanged);
+  EMIT_IF_CHANGED(udpPort, udpPortChanged);
+  EMIT_IF_CHANGED(tlsPort, tlsPortChanged);
+  if (mSnapshot.audioPortRange != previous.audioPortRange)
+    emit audioPortRangeChanged(mSnapshot.audioPortRange[0], mSnapshot.audioPortRange[1]);
+  if (mSnapshot.videoPortRange != previous.videoPortRange)
+    emit videoPortRangeChanged(mSnapshot.videoPortRange[0], mSnapshot.videoPortRange[1]);
+  EMIT_IF_CHANGED(iceEnabled, iceEnabledChanged);
+  EMIT_IF_CHANGED(turnEnabled, turnEnabledChanged);
+  EMIT_IF_CHANGED(stunServer, stunServerChanged);
+  EMIT_IF_CHANGED(turnUser, turnUserChanged);
+  EMIT_IF_CHANGED(dscpSip, dscpSipChanged);
+  EMIT_IF_CHANGED(dscpAudio, dscpAudioChanged);
+  EMIT_IF_CHANGED(dscpVideo, dscpVideoChanged);
+  EMIT_IF_CHANGED(rlsUriEnabled, rlsUriEnabledChanged);
+
+  // UI.
+  EMIT_IF_CHANGED(savedScreenshotsFolder, savedScreenshotsFolderChanged);
+  EMIT_IF_CHANGED(savedVideosFolder, savedVideosFolderChanged);
+  EMIT_IF_CHANGED(downloadFolder, downloadFolderChanged);
+  EMIT_IF_CHANGED(remoteProvisioning, remoteProvisioningChanged);
+  EMIT_IF_CHANGED(exitOnClose, exitOnCloseChanged);
+
+  // Advanced.
+  EMIT_IF_CHANGED(logsFolder, logsFolderChanged);
+  EMIT_IF_CHANGED(logsUploadUrl, logsUploadUrlChanged);
+  EMIT_IF_CHANGED(logsEnabled, logsEnabledChanged);
+  EMIT_IF_CHANGED(logsEmail, logsEmailChanged);
+  EMIT_IF_CHANGED(logsLevels, logsLevelsChanged);
+}
+
+#undef EMIT_IF_CHANGED
+
+void SettingsModel::loadSnapshot () {
+  shared_ptr<linphone::Core> core = CoreManager::getInstance()->getCore();
+  shared_ptr<linphone::NatPolicy> natPolicy = core->getNatPolicy();
+
+  // Audio.
+  mSnapshot.captureDevice = ::Utils::coreStringToAppString(core->getCaptureDevice());
+  mSnapshot.playbackDevice = ::Utils::coreStringToAppString(core->getPlaybackDevice());
+  mSnapshot.ringerDevice = ::Utils::coreStringToAppString(core->getRingerDevice());
+  mSnapshot.ringPath = ::Utils::coreStringToAppString(core->getRing());
+  mSnapshot.echoCancellationEnabled = core->echoCancellationEnabled();
+
+  // Video.
+  mSnapshot.videoDevice = ::Utils::coreStringToAppString(core->getVideoDevice());
+  mSnapshot.videoPreset = ::Utils::coreStringToAppString(core->getVideoPreset());
+  mSnapshot.videoFramerate = static_cast<int>(core->getPreferredFramerate());
+  mSnapshot.videoDefinition = ::createMapFromVideoDefinition(core->getPreferredVideoDefinition());
+
+  // Chat & calls.
+  mSnapshot.autoAnswerStatus = !!mConfig->getInt(UI_SECTION, "auto_answer", 0);
+  mSnapshot.autoAnswerVideoStatus = !!mConfig->getInt(UI_SECTION, "auto_answer_with_video", 0);
+  mSnapshot.autoAnswerDelay = mConfig->getInt(UI_SECTION, "auto_answer_delay", 0);
+  mSnapshot.fileTransferUrl = ::Utils::coreStringToAppString(core->getFileTransferServer());
+  mSnapshot.mediaEncryption = static_cast<MediaEncryption>(core->getMediaEncryption());
+  mSnapshot.limeState = static_cast<LimeState>(core->limeEnabled());
+
+  // Network.
+  mSnapshot.useSipInfoForDtmfs = core->getUseInfoForDtmf();
+  mSnapshot.useRfc2833ForDtmfs = core->getUseRfc2833ForDtmf();
+  mSnapshot.ipv6Enabled = core->ipv6Enabled();
+  mSnapshot.downloadBandwidth = core->getDownloadBandwidth();
+  mSnapshot.uploadBandwidth = core->getUploadBandwidth();
+  mSnapshot.adaptiveRateControlEnabled = core->adaptiveRateControlEnabled();
+
+  {
+    shared_ptr<linphone::Transports> transports = core->getTransports();
+    mSnapshot.tcpPort = transports->getTcpPort();
+    mSnapshot.udpPort = transports->getUdpPort();
+    mSnapshot.tlsPort = transports->getTlsPort();
+  }
+
+  {
+    shared_ptr<linphone::Range> range = core->getAudioPortsRange();
+    mSnapshot.audioPortRange = QList<int>() << range->getMin() << range->getMax();
+
+    range = core->getVideoPortsRange();
+    mSnapshot.videoPortRange = QList<int>() << range->getMin() << range->getMax();
+  }
+
+  mSnapshot.iceEnabled = natPolicy->iceEnabled();
+  mSnapshot.turnEnabled = natPolicy->turnEnabled();
+  mSnapshot.stunServer = ::Utils::coreStringToAppString(natPolicy->getStunServer());
+  mSnapshot.turnUser = ::Utils::coreStringToAppString(natPolicy->getStunServerUsername());
+  mSnapshot.dscpSip = core->getSipDscp();
+  mSnapshot.dscpAudio = core->getAudioDscp();
+  mSnapshot.dscpVideo = core->getVideoDscp();
+  mSnapshot.rlsUriEnabled = !!mConfig->getInt(UI_SECTION, "rls_uri_enabled", true);
+
+  // UI.
+  mSnapshot.savedScreenshotsFolder = ::getFolder(mConfig, "saved_screenshots_folder", Paths::getCapturesDirPath());
+  mSnapshot.savedVideosFolder = ::getFolder(mConfig, "saved_videos_folder", Paths::getCapturesDirPath());
+  mSnapshot.downloadFolder = ::getFolder(mConfig, "download_folder", Paths::getDownloadDirPath());
+  mSnapshot.remoteProvisioning = ::Utils::coreStringToAppString(core->getProvisioningUri());
+  mSnapshot.exitOnClose = !!mConfig->getInt(UI_SECTION, "exit_on_close", 0);
+
+  // Advanced.
+  mSnapshot.logsFolder = getLogsFolder(mConfig);
+  mSnapshot.logsUploadUrl = ::Utils::coreStringToAppString(core->getLogCollectionUploadServerUrl());
+  mSnapshot.logsEnabled = getLogsEnabled(mConfig);
+  mSnapshot.logsEmail = ::Utils::coreStringToAppString(mConfig->getString(UI_SECTION, "logs_email", ""));
+  mSnapshot.logsLevels = getLogsLevels(mConfig);
+}
+
+// -----------------------------------------------------------------------------
+
+// The core can select another device when the used one is unplugged.
+static inline bool updateDevice (QString &device, const string &newDevice) {
+  const QString name = ::Utils::coreStringToAppString(newDevice);
+  if (device == name)
+    return false;
+
+  device = name;
+  return true;
+}
+
+void SettingsModel::handleSoundDevicesChanged () {
+  emit captureDevicesChanged(mDevicesRegistry->getCaptureDevices());
+  emit playbackDevicesChanged(mDevicesRegistry->getPlaybackDevices());
+
+  shared_ptr<linphone::Core> core = CoreManager::getInstance()->getCore();
+  if (::updateDevice(mSnapshot.captureDevice, core->getCaptureDevice()))
+    emit captureDeviceChanged(mSnapshot.captureDevice);
+  if (::updateDevice(mSnapshot.playbackDevice, core->getPlaybackDevice()))
+    emit playbackDeviceChanged(mSnapshot.playbackDevice);
+  if (::updateDevice(mSnapshot.ringerDevice, core->getRingerDevice()))
+    emit ringerDeviceChanged(mSnapshot.ringerDevice);
+}
+
+void SettingsModel::handleVideoDevicesChanged () {
+  emit videoDevicesChanged(mDevicesRegistry->getVideoDevices());
+
+  if (::updateDevice(mSnapshot.videoDevice, CoreManager::getInstance()->getCore()->getVideoDevice()))
+    emit videoDeviceChanged(mSnapshot.videoDevice);
+}
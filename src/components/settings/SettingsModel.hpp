@@ -25,9 +25,12 @@
 
 #include <linphone++/linphone.hh>
 #include <QObject>
+#include <QVariant>
 
 // =============================================================================
 
+class DevicesRegistry;
+
 class SettingsModel : public QObject {
   Q_OBJECT;
 
@@ -37,8 +40,8 @@ class SettingsModel : public QObject {
 
   // Audio. --------------------------------------------------------------------
 
-  Q_PROPERTY(QStringList captureDevices READ getCaptureDevices CONSTANT);
-  Q_PROPERTY(QStringList playbackDevices READ getPlaybackDevices CONSTANT);
+  Q_PROPERTY(QStringList captureDevices READ getCaptureDevices NOTIFY captureDevicesChanged);
+  Q_PROPERTY(QStringList playbackDevices READ getPlaybackDevices NOTIFY playbackDevicesChanged);
 
   Q_PROPERTY(QString captureDevice READ getCaptureDevice WRITE setCaptureDevice NOTIFY captureDeviceChanged);
   Q_PROPERTY(QString playbackDevice READ getPlaybackDevice WRITE setPlaybackDevice NOTIFY playbackDeviceChanged);
@@ -50,7 +53,7 @@ class SettingsModel : public QObject {
 
   // Video. --------------------------------------------------------------------
 
-  Q_PROPERTY(QStringList videoDevices READ getVideoDevices CONSTANT);
+  Q_PROPERTY(QStringList videoDevices READ getVideoDevices NOTIFY videoDevicesChanged);
 
   Q_PROPERTY(QString videoDevice READ getVideoDevice WRITE setVideoDevice NOTIFY videoDeviceChanged);
 
@@ -129,6 +132,7 @@ class SettingsModel : public QObject {
   Q_PROPERTY(QString logsUploadUrl READ getLogsUploadUrl WRITE setLogsUploadUrl NOTIFY logsUploadUrlChanged);
   Q_PROPERTY(bool logsEnabled READ getLogsEnabled WRITE setLogsEnabled NOTIFY logsEnabledChanged);
   Q_PROPERTY(QString logsEmail READ getLogsEmail WRITE setLogsEmail NOTIFY logsEmailChanged);
+  Q_PROPERTY(QString logsLevels READ getLogsLevels WRITE setLogsLevels NOTIFY logsLevelsChanged);
 
 public:
   enum MediaEncryption {
@@ -311,10 +315,20 @@ public:
   QString getLogsEmail () const;
   void setLogsEmail (const QString &email);
 
+  QString getLogsLevels () const;
+  void setLogsLevels (const QString &levels);
+
+  // ---------------------------------------------------------------------------
+
+  // Reads the settings again and notifies the changed ones.
+  // To call after a write which does not use this model. (Assistant config files...)
+  void reloadSnapshot ();
+
   // ---------------------------------------------------------------------------
 
   static QString getLogsFolder (const std::shared_ptr<linphone::Config> &config);
   static bool getLogsEnabled (const std::shared_ptr<linphone::Config> &config);
+  static QString getLogsLevels (const std::shared_ptr<linphone::Config> &config);
 
   static const std::string UI_SECTION;
 
@@ -325,6 +339,9 @@ public:
 signals:
   // Audio. --------------------------------------------------------------------
 
+  void captureDevicesChanged (const QStringList &devices);
+  void playbackDevicesChanged (const QStringList &devices);
+
   void captureDeviceChanged (const QString &device);
   void playbackDeviceChanged (const QString &device);
   void ringerDeviceChanged (const QString &device);
@@ -335,6 +352,8 @@ signals:
 
   // Video. --------------------------------------------------------------------
 
+  void videoDevicesChanged (const QStringList &devices);
+
   void videoDeviceChanged (const QString &device);
 
   void videoPresetChanged (const QString &preset);
@@ -402,9 +421,78 @@ signals:
   void logsUploadUrlChanged (const QString &url);
   void logsEnabledChanged (bool status);
   void logsEmailChanged (const QString &email);
+  void logsLevelsChanged (const QString &levels);
 
 private:
+  // Typed copy of the settings, read once from the core and the config.
+  // Setters write through and update it, so getters are plain member loads.
+  struct Snapshot {
+    // Audio.
+    QString captureDevice;
+    QString playbackDevice;
+    QString ringerDevice;
+    QString ringPath;
+    bool echoCancellationEnabled;
+
+    // Video.
+    QString videoDevice;
+    QString videoPreset;
+    int videoFramerate;
+    QVariantMap videoDefinition;
+
+    // Chat & calls.
+    bool autoAnswerStatus;
+    bool autoAnswerVideoStatus;
+    int autoAnswerDelay;
+    QString fileTransferUrl;
+    MediaEncryption mediaEncryption;
+    LimeState limeState;
+
+    // Network.
+    bool useSipInfoForDtmfs;
+    bool useRfc2833ForDtmfs;
+    bool ipv6Enabled;
+    int downloadBandwidth;
+    int uploadBandwidth;
+    bool adaptiveRateControlEnabled;
+    int tcpPort;
+    int udpPort;
+    int tlsPort;
+    QList<int> audioPortRange;
+    QList<int> videoPortRange;
+    bool iceEnabled;
+    bool turnEnabled;
+    QString stunServer;
+    QString turnUser;
+    int dscpSip;
+    int dscpAudio;
+    int dscpVideo;
+    bool rlsUriEnabled;
+
+    // UI.
+    QString savedScreenshotsFolder;
+    QString savedVideosFolder;
+    QString downloadFolder;
+    QString remoteProvisioning;
+    bool exitOnClose;
+
+    // Advanced.
+    QString logsFolder;
+    QString logsUploadUrl;
+    bool logsEnabled;
+    QString logsEmail;
+    QString logsLevels;
+  };
+
+  void loadSnapshot ();
+
+  void handleSoundDevicesChanged ();
+  void handleVideoDevicesChanged ();
+
   std::shared_ptr<linphone::Config> mConfig;
+  Snapshot mSnapshot;
+
+  DevicesRegistry *mDevicesRegistry = nullptr;
 };
 
 Q_DECLARE_METATYPE(std::shared_ptr<const linphone::VideoDefinition> );
@@ -0,0 +1,99 @@
+/*
+ * SoundFilesCache.cpp
+ * Copyright (C) 2026  Belledonne Communications, Grenoble, France
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *  Created on: October 17, 2026
+ */
+
+#include <QFile>
+#include <QtConcurrent>
+
+#ifdef Q_OS_LINUX
+  #include <fcntl.h>
+#endif // ifdef Q_OS_LINUX
+
+#include "../../utils/Utils.hpp"
+#include "../core/CoreManager.hpp"
+
+#include "SoundFilesCache.hpp"
+
+// Bigger files are not prefetched, they would only evict other pages.
+#define MAX_SOUND_FILE_SIZE 10485760 /* 10MB. */
+
+#define READ_BUFFER_SIZE 65536
+
+using namespace std;
+
+// =============================================================================
+
+static void prefetch (const QString &path) {
+  QFile file(path);
+  const qint64 size = file.size();
+  if (size > MAX_SOUND_FILE_SIZE) {
+    qInfo() << QStringLiteral("Sound file too big to be prefetched: `%1` (%2 bytes).").arg(path).arg(size);
+    return;
+  }
+
+  if (size <= 0 || !file.open(QIODevice::ReadOnly)) {
+    qWarning() << QStringLiteral("Unable to prefetch sound file: `%1`.").arg(path);
+    return;
+  }
+
+  #ifdef Q_OS_LINUX
+    // Asynchronous readahead by the kernel.
+    if (!posix_fadvise(file.handle(), 0, off_t(size), POSIX_FADV_WILLNEED)) {
+      qInfo() << QStringLiteral("Sound file prefetched: `%1` (%2 bytes).").arg(path).arg(size);
+      return;
+    }
+  #endif // ifdef Q_OS_LINUX
+
+  // Otherwise the file is read once, it stays in the page cache.
+  char buf[READ_BUFFER_SIZE];
+  while (file.read(buf, sizeof buf) > 0) {}
+
+  qInfo() << QStringLiteral("Sound file prefetched: `%1` (%2 bytes).").arg(path).arg(size);
+}
+
+// -----------------------------------------------------------------------------
+
+SoundFilesCache::SoundFilesCache (QObject *parent) : QObject(parent) {
+  SettingsModel *settingsModel = CoreManager::getInstance()->getSettingsModel();
+  QObject::connect(settingsModel, &SettingsModel::ringPathChanged, this, &SoundFilesCache::update);
+
+  // A new device may be opened by the ringer: the files are read again, in
+  // case their pages were evicted since the startup.
+  QObject::connect(settingsModel, &SettingsModel::ringerDeviceChanged, this, &SoundFilesCache::update);
+
+  update();
+}
+
+// -----------------------------------------------------------------------------
+
+void SoundFilesCache::update () {
+  shared_ptr<linphone::Core> core = CoreManager::getInstance()->getCore();
+
+  QStringList paths;
+  for (const auto &path : { core->getRing(), core->getRingback(), core->getPlayFile() })
+    if (!path.empty())
+      paths << ::Utils::coreStringToAppString(path);
+  paths.removeDuplicates();
+
+  QtConcurrent::run([paths] {
+    for (const auto &path : paths)
+      ::prefetch(path);
+  });
+}
@@ -0,0 +1,43 @@
+/*
+ * SoundFilesCache.hpp
+ * Copyright (C) 2026  Belledonne Communications, Grenoble, France
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *  Created on: October 17, 2026
+ */
+
+#ifndef SOUND_FILES_CACHE_H_
+#define SOUND_FILES_CACHE_H_
+
+#include <QObject>
+
+// =============================================================================
+
+// Prefetches the sound files played by the core (ring, ringback and hold
+// music) in the system page cache, so a ringing does not wait for the disk.
+// The files are read in background and closed right after.
+class SoundFilesCache : public QObject {
+  Q_OBJECT;
+
+public:
+  SoundFilesCache (QObject *parent = Q_NULLPTR);
+  ~SoundFilesCache () = default;
+
+private:
+  void update ();
+};
+
+#endif // SOUND_FILES_CACHE_H_
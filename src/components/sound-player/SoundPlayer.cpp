@@ -27,8 +27,6 @@
 
 #include "SoundPlayer.hpp"
 
-#define FORCE_CLOSE_TIMER_INTERVAL 20
-
 using namespace std;
 
 // =============================================================================
@@ -41,14 +39,12 @@ public:
 
 private:
   void onEofReached (const shared_ptr<linphone::Player> &) override {
-    QMutex &mutex = mSoundPlayer->mForceCloseMutex;
-
-    // Workaround.
     // This callback is called in a standard thread of mediastreamer, not a QThread.
-    // Signals, connect functions, timers... are unavailable.
-    mutex.lock();
-    mSoundPlayer->mForceClose = true;
-    mutex.unlock();
+    // The event is posted in the thread of the sound player.
+    QMetaObject::invokeMethod(
+      mSoundPlayer, "handleEof", Qt::QueuedConnection,
+      Q_ARG(int, mSoundPlayer->mPlaybackId.load())
+    );
   }
 
   SoundPlayer *mSoundPlayer;
@@ -57,10 +53,8 @@ private:
 // -----------------------------------------------------------------------------
 
 SoundPlayer::SoundPlayer (QObject *parent) : QObject(parent) {
-  mForceCloseTimer = new QTimer(this);
-  mForceCloseTimer->setInterval(FORCE_CLOSE_TIMER_INTERVAL);
-
-  QObject::connect(mForceCloseTimer, &QTimer::timeout, this, &SoundPlayer::handleEof);
+  mProgressTimer = new QTimer(this);
+  QObject::connect(mProgressTimer, &QTimer::timeout, this, &SoundPlayer::emitPositionChanged);
 
   mHandlers = make_shared<SoundPlayer::Handlers>(this);
 
@@ -68,7 +62,6 @@ SoundPlayer::SoundPlayer (QObject *parent) : QObject(parent) {
 }
 
 SoundPlayer::~SoundPlayer () {
-  mForceCloseTimer->stop();
   mInternalPlayer->close();
 }
 
@@ -83,7 +76,7 @@ void SoundPlayer::pause () {
     return;
   }
 
-  mForceCloseTimer->stop();
+  mProgressTimer->stop();
   mPlaybackState = SoundPlayer::PausedState;
 
   emit paused();
@@ -94,12 +87,12 @@ void SoundPlayer::play () {
   if (mPlaybackState == SoundPlayer::PlayingState)
     return;
 
-  if (
-    (mPlaybackState == SoundPlayer::StoppedState || mPlaybackState == SoundPlayer::ErrorState) &&
-    mInternalPlayer->open(::Utils::appStringToCoreString(mSource))
-  ) {
-    qWarning() << QStringLiteral("Unable to open: `%1`").arg(mSource);
-    return;
+  if (mPlaybackState == SoundPlayer::StoppedState || mPlaybackState == SoundPlayer::ErrorState) {
+    mPlaybackId.ref();
+    if (mInternalPlayer->open(::Utils::appStringToCoreString(mSource))) {
+      qWarning() << QStringLiteral("Unable to open: `%1`").arg(mSource);
+      return;
+    }
   }
 
   if (mInternalPlayer->start()
@@ -108,7 +101,8 @@ void SoundPlayer::play () {
     return;
   }
 
-  mForceCloseTimer->start();
+  if (mProgressTimer->interval() > 0)
+    mProgressTimer->start();
   mPlaybackState = SoundPlayer::PlayingState;
 
   emit playing();
@@ -123,6 +117,8 @@ void SoundPlayer::stop () {
 
 void SoundPlayer::seek (int offset) {
   mInternalPlayer->seek(offset);
+  if (mProgressTimer->interval() > 0)
+    emitPositionChanged();
 }
 
 // -----------------------------------------------------------------------------
@@ -156,7 +152,7 @@ void SoundPlayer::stop (bool force) {
   if (mPlaybackState == SoundPlayer::StoppedState && !force)
     return;
 
-  mForceCloseTimer->stop();
+  mProgressTimer->stop();
   mPlaybackState = SoundPlayer::StoppedState;
 
   mInternalPlayer->close();
@@ -167,15 +163,9 @@ void SoundPlayer::stop (bool force) {
 
 // -----------------------------------------------------------------------------
 
-void SoundPlayer::handleEof () {
-  mForceCloseMutex.lock();
-
-  if (mForceClose) {
-    mForceClose = false;
+void SoundPlayer::handleEof (int playbackId) {
+  if (playbackId == mPlaybackId.load() && mPlaybackState != SoundPlayer::StoppedState)
     stop();
-  }
-
-  mForceCloseMutex.unlock();
 }
 
 // -----------------------------------------------------------------------------
@@ -233,3 +223,27 @@ void SoundPlayer::setPlaybackState (PlaybackState playbackState) {
 int SoundPlayer::getDuration () const {
   return mInternalPlayer->getDuration();
 }
+
+// -----------------------------------------------------------------------------
+
+int SoundPlayer::getProgressInterval () const {
+  return mProgressTimer->interval();
+}
+
+void SoundPlayer::setProgressInterval (int interval) {
+  interval = qMax(interval, 0);
+  if (interval == mProgressTimer->interval())
+    return;
+
+  mProgressTimer->setInterval(interval);
+  if (!interval)
+    mProgressTimer->stop();
+  else if (mPlaybackState == SoundPlayer::PlayingState)
+    mProgressTimer->start();
+
+  emit progressIntervalChanged(interval);
+}
+
+void SoundPlayer::emitPositionChanged () {
+  emit positionChanged(getPosition(), getDuration());
+}
@@ -25,7 +25,7 @@
 
 #include <memory>
 
-#include <QMutex>
+#include <QAtomicInt>
 #include <QObject>
 
 // =============================================================================
@@ -45,6 +45,9 @@ class SoundPlayer : public QObject {
   Q_PROPERTY(PlaybackState playbackState READ getPlaybackState WRITE setPlaybackState NOTIFY playbackStateChanged);
   Q_PROPERTY(int duration READ getDuration NOTIFY sourceChanged);
 
+  // Interval in ms of the `positionChanged` signal while playing. Disabled if 0.
+  Q_PROPERTY(int progressInterval READ getProgressInterval WRITE setProgressInterval NOTIFY progressIntervalChanged);
+
 public:
   enum PlaybackState {
     PlayingState,
@@ -75,13 +78,17 @@ signals:
 
   void playbackStateChanged (PlaybackState playbackState);
 
+  void progressIntervalChanged (int interval);
+  void positionChanged (int position, int duration);
+
 private:
   void buildInternalPlayer ();
   void rebuildInternalPlayer ();
 
   void stop (bool force);
 
-  void handleEof ();
+  // Called in the app thread, `playbackId` is the value of `mPlaybackId` at the end of file.
+  Q_INVOKABLE void handleEof (int playbackId);
 
   void setError (const QString &message);
 
@@ -93,13 +100,18 @@ private:
 
   int getDuration () const;
 
+  int getProgressInterval () const;
+  void setProgressInterval (int interval);
+
+  void emitPositionChanged ();
+
   QString mSource;
   PlaybackState mPlaybackState = StoppedState;
 
-  bool mForceClose = false;
-  QMutex mForceCloseMutex;
+  // Incremented at each opening, ignores the end of a previous playback.
+  QAtomicInt mPlaybackId;
 
-  QTimer *mForceCloseTimer = nullptr;
+  QTimer *mProgressTimer = nullptr;
 
   std::shared_ptr<linphone::Player> mInternalPlayer;
   std::shared_ptr<Handlers> mHandlers;
@@ -0,0 +1,75 @@
+/*
+ * CliTest.cpp
+ * Copyright (C) 2026  Belledonne Communications, Grenoble, France
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *  Created on: October 17, 2026
+ */
+
+#include <QTest>
+
+#include "../../app/cli/Cli.hpp"
+
+#include "CliTest.hpp"
+
+// =============================================================================
+
+void CliTest::checkParseCommand () {
+  QString functionName;
+  QHash<QString, QString> args;
+  QString error;
+
+  QVERIFY(Cli::parseCommand("show", functionName, args, error));
+  QCOMPARE(functionName, QStringLiteral("show"));
+  QVERIFY(args.isEmpty());
+
+  QVERIFY(Cli::parseCommand(
+    "  join-conference sip-address=sip:toto@sip.linphone.org conference-id = 42\tdisplay-name=toto  ",
+    functionName, args, error
+  ));
+  QCOMPARE(functionName, QStringLiteral("join-conference"));
+  QCOMPARE(args.size(), 3);
+  QCOMPARE(args["sip-address"], QStringLiteral("sip:toto@sip.linphone.org"));
+  QCOMPARE(args["conference-id"], QStringLiteral("42"));
+  QCOMPARE(args["display-name"], QStringLiteral("toto"));
+}
+
+void CliTest::checkParseQuotedValues () {
+  QString functionName;
+  QHash<QString, QString> args;
+  QString error;
+
+  QVERIFY(Cli::parseCommand(
+    "join-conference display-name=\"Toto \\\"the\\\" \\\\ best\" conference-id=\"\" sip-address=\"sip:a@b\"",
+    functionName, args, error
+  ));
+  QCOMPARE(args["display-name"], QStringLiteral("Toto \"the\" \\ best"));
+  QCOMPARE(args["conference-id"], QString(""));
+  QCOMPARE(args["sip-address"], QStringLiteral("sip:a@b"));
+}
+
+void CliTest::checkParseErrors () {
+  QString functionName;
+  QHash<QString, QString> args;
+  QString error;
+
+  QVERIFY(!Cli::parseCommand("", functionName, args, error));
+  QVERIFY(!Cli::parseCommand("Show", functionName, args, error));
+  QVERIFY(!Cli::parseCommand("call sip-address", functionName, args, error));
+  QVERIFY(!Cli::parseCommand("call =sip:a@b", functionName, args, error));
+  QVERIFY(!Cli::parseCommand("call sip-address=\"sip:a@b", functionName, args, error));
+  QVERIFY(!error.isEmpty());
+}
@@ -0,0 +1,144 @@
+/*
+ * ExifImageHeaderTest.cpp
+ * Copyright (C) 2026  Belledonne Communications, Grenoble, France
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *  Created on: October 17, 2026
+ */
+
+#include <QBuffer>
+#include <QDataStream>
+#include <QImage>
+#include <QTest>
+
+#include "../../utils/QExifImageHeader.h"
+
+#include "ExifImageHeaderTest.hpp"
+
+#define TEST_ORIENTATION 6
+
+// =============================================================================
+
+// A TIFF header with one image IFD: `Make` and `Orientation`.
+static QByteArray createTiffHeader (bool littleEndian) {
+  QByteArray data;
+  QDataStream stream(&data, QIODevice::WriteOnly);
+  stream.setByteOrder(littleEndian ? QDataStream::LittleEndian : QDataStream::BigEndian);
+
+  stream.writeRawData(littleEndian ? "II" : "MM", 2);
+  stream << quint16(0x002A) << quint32(8);
+
+  stream << quint16(2);
+  stream << quint16(QExifImageHeader::Make) << quint16(QExifValue::Ascii) << quint32(4);
+  stream.writeRawData("abc", 4);
+  stream << quint16(QExifImageHeader::Orientation) << quint16(QExifValue::Short) << quint32(1)
+    << quint16(TEST_ORIENTATION) << quint16(0);
+
+  // No next IFD.
+  stream << quint32(0);
+
+  return data;
+}
+
+static QByteArray createSegment (quint8 marker, const QByteArray &payload) {
+  QByteArray data;
+  QDataStream stream(&data, QIODevice::WriteOnly);
+  stream << quint8(0xFF) << marker << quint16(payload.size() + 2);
+  stream.writeRawData(payload.constData(), payload.size());
+  return data;
+}
+
+static QByteArray createExifSegment (bool littleEndian) {
+  return ::createSegment(0xE1, QByteArray("Exif\0\0", 6) + ::createTiffHeader(littleEndian));
+}
+
+// Inserts the segments after the start of image marker of a real jpeg.
+static QByteArray createJpeg (const QList<QByteArray> &segments) {
+  QByteArray jpeg;
+  QBuffer buffer(&jpeg);
+  buffer.open(QIODevice::WriteOnly);
+
+  QImage image(64, 64, QImage::Format_RGB32);
+  image.fill(Qt::red);
+  image.save(&buffer, "jpg");
+
+  QByteArray result = jpeg.left(2);
+  for (const auto &segment : segments)
+    result += segment;
+  return result + jpeg.mid(2);
+}
+
+static bool readOrientation (const QByteArray &jpeg, quint32 &value) {
+  return QExifImageHeader::readImageTag(
+    reinterpret_cast<const uchar *>(jpeg.constData()), jpeg.size(), QExifImageHeader::Orientation, value
+  );
+}
+
+// -----------------------------------------------------------------------------
+
+void ExifImageHeaderTest::checkReadImageTag () {
+  for (bool littleEndian : { true, false }) {
+    QByteArray jpeg = ::createJpeg({ ::createExifSegment(littleEndian) });
+
+    quint32 value = 0;
+    QVERIFY(::readOrientation(jpeg, value));
+    QCOMPARE(value, quint32(TEST_ORIENTATION));
+
+    // Same value with the full parser.
+    QBuffer buffer(&jpeg);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QExifImageHeader header;
+    QVERIFY(header.loadFromJpeg(&buffer));
+    QCOMPARE(quint32(header.value(QExifImageHeader::Orientation).toShort()), value);
+
+    // Not an integer.
+    QVERIFY(!QExifImageHeader::readImageTag(
+      reinterpret_cast<const uchar *>(jpeg.constData()), jpeg.size(), QExifImageHeader::Make, value
+    ));
+
+    // Missing.
+    QVERIFY(!QExifImageHeader::readImageTag(
+      reinterpret_cast<const uchar *>(jpeg.constData()), jpeg.size(), QExifImageHeader::Software, value
+    ));
+  }
+
+  // EXIF after another APP1 segment.
+  quint32 value = 0;
+  QVERIFY(::readOrientation(::createJpeg({
+    ::createSegment(0xE1, QByteArray("http://ns.adobe.com/xap/1.0/\0<x/>", 33)),
+    ::createExifSegment(false)
+  }), value));
+  QCOMPARE(value, quint32(TEST_ORIENTATION));
+}
+
+void ExifImageHeaderTest::checkInvalidImages () {
+  quint32 value;
+
+  // Without EXIF.
+  QVERIFY(!::readOrientation(::createJpeg({}), value));
+
+  // Not a jpeg.
+  QVERIFY(!::readOrientation(QByteArray("invalid"), value));
+
+  // Truncated EXIF segment.
+  const QByteArray jpeg = ::createJpeg({ ::createExifSegment(true) });
+  QVERIFY(!::readOrientation(jpeg.left(30), value));
+
+  // Invalid IFD offset.
+  QByteArray invalidJpeg = jpeg;
+  invalidJpeg[16] = '\x7F';
+  QVERIFY(!::readOrientation(invalidJpeg, value));
+}
@@ -0,0 +1,102 @@
+/*
+ * ImageScalerTest.cpp
+ * Copyright (C) 2026  Belledonne Communications, Grenoble, France
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *  Created on: October 17, 2026
+ */
+
+#include <cstdlib>
+
+#include <QTest>
+
+#include "../../utils/ImageScaler.hpp"
+
+#include "ImageScalerTest.hpp"
+
+// Max differences with `QImage::scaled`, per channel.
+#define MAX_MEAN_DIFFERENCE 2.0
+#define MAX_DIFFERENCE 32
+
+// =============================================================================
+
+// Gradients with a checkerboard, like a photo with details.
+static QImage createImage (int width, int height, bool alpha) {
+  QImage image(width, height, alpha ? QImage::Format_ARGB32_Premultiplied : QImage::Format_RGB32);
+  for (int y = 0; y < height; ++y) {
+    QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(y));
+    for (int x = 0; x < width; ++x) {
+      const int checker = ((x / 7 + y / 7) % 2) * 64;
+      const int a = alpha ? 128 + (x * 127) / width : 255;
+      line[x] = qPremultiply(qRgba(
+        (x * 191) / width + checker,
+        (y * 191) / height + checker,
+        ((x + y) * 95) / (width + height) + checker,
+        a
+      ));
+    }
+  }
+  return image;
+}
+
+// -----------------------------------------------------------------------------
+
+void ImageScalerTest::checkBoxReduce () {
+  QImage image(5, 5, QImage::Format_RGB32);
+  for (int y = 0; y < image.height(); ++y)
+    for (int x = 0; x < image.width(); ++x)
+      image.setPixel(x, y, qRgb(x * 10, y * 10, (x + y) * 10));
+
+  // The last column and row are averaged in the last blocks.
+  const QImage result = ImageScaler::boxReduce(image, 2, 2);
+  QCOMPARE(result.size(), QSize(2, 2));
+  QCOMPARE(result.format(), QImage::Format_RGB32);
+  QCOMPARE(result.pixel(0, 0), qRgb(5, 5, 10));
+  QCOMPARE(result.pixel(1, 0), qRgb(30, 5, 35));
+  QCOMPARE(result.pixel(0, 1), qRgb(5, 30, 35));
+  QCOMPARE(result.pixel(1, 1), qRgb(30, 30, 60));
+}
+
+void ImageScalerTest::checkScaled () {
+  for (bool alpha : { false, true }) {
+    const QImage image = ::createImage(1920, 1080, alpha);
+
+    const QImage result = ImageScaler::scaled(image, QSize(100, 100));
+    const QImage expected = image.scaled(100, 100, Qt::KeepAspectRatio, Qt::SmoothTransformation)
+      .convertToFormat(result.format());
+    QCOMPARE(result.size(), expected.size());
+
+    qint64 sum = 0;
+    int max = 0;
+    for (int y = 0; y < result.height(); ++y) {
+      const uchar *a = result.constScanLine(y);
+      const uchar *b = expected.constScanLine(y);
+      for (int x = 0; x < result.width() * 4; ++x) {
+        const int difference = abs(a[x] - b[x]);
+        sum += difference;
+        max = qMax(max, difference);
+      }
+    }
+
+    const double mean = double(sum) / (result.width() * result.height() * 4);
+    QVERIFY2(mean <= MAX_MEAN_DIFFERENCE, qPrintable(QStringLiteral("Mean difference: %1.").arg(mean)));
+    QVERIFY2(max <= MAX_DIFFERENCE, qPrintable(QStringLiteral("Max difference: %1.").arg(max)));
+  }
+
+  // Upscaling is done by Qt.
+  QCOMPARE(ImageScaler::scaled(::createImage(50, 50, false), QSize(100, 100)).size(), QSize(100, 100));
+  QVERIFY(ImageScaler::scaled(QImage(), QSize(100, 100)).isNull());
+}
@@ -0,0 +1,237 @@
+/*
+ * LoggerTest.cpp
+ * Copyright (C) 2026  Belledonne Communications, Grenoble, France
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *  Created on: October 17, 2026
+ */
+
+#include <bctoolbox/logging.h>
+#include <QLoggingCategory>
+#include <QTest>
+#include <QThread>
+
+#include "../../app/logger/Logger.hpp"
+
+#include "LoggerTest.hpp"
+
+#define LOG_DOMAIN "belle-sip"
+#define LOG_MESSAGE "channel [0x55d5c1a3e0]: message sent to [UDP://sip.linphone.org:5060], size: [512] bytes"
+
+#define TEST_DOMAIN "logger-test"
+#define TEST_CATEGORY "logger.test"
+#define TEST_INTERVAL 200
+
+// =============================================================================
+
+// Rate limit states are kept per call site, each check uses its own keys.
+static bool checkRateLimit (int level, quint64 key, int &suppressed) {
+  return Logger::getInstance()->checkRateLimit(TEST_DOMAIN, level, key, nullptr, suppressed);
+}
+
+// -----------------------------------------------------------------------------
+
+void LoggerTest::initTestCase () {
+  mLogLevels = Logger::getInstance()->getLogLevels();
+  mRateLimits = Logger::getInstance()->getRateLimits();
+}
+
+void LoggerTest::cleanupTestCase () {
+  Logger::getInstance()->setLogLevels(mLogLevels);
+  Logger::getInstance()->setRateLimits(mRateLimits);
+}
+
+// -----------------------------------------------------------------------------
+
+void LoggerTest::checkFormatLine () {
+  const QByteArray &line = Logger::formatLine(BCTBX_LOG_WARNING, LOG_DOMAIN, nullptr, nullptr, LOG_MESSAGE);
+  QVERIFY(line.contains("[Warning]"));
+  QVERIFY(line.contains("Core:" LOG_DOMAIN ": "));
+  QVERIFY(line.endsWith(LOG_MESSAGE "\n"));
+
+  // The line buffer is reused.
+  const QByteArray &qtLine = Logger::formatLine(BCTBX_LOG_MESSAGE, nullptr, this, "file.cpp:42: ", "Qt message");
+  QCOMPARE(&qtLine, &line);
+  QVERIFY(qtLine.contains("[Info]"));
+  QVERIFY(qtLine.contains("file.cpp:42: "));
+  QVERIFY(qtLine.endsWith("Qt message\n"));
+
+  QVERIFY(Logger::formatLine(BCTBX_LOG_ERROR, nullptr, this, "", "Qt message").contains("[Critical]"));
+  QVERIFY(Logger::formatLine(BCTBX_LOG_ERROR, LOG_DOMAIN, nullptr, nullptr, LOG_MESSAGE).contains("[Error]"));
+}
+
+// -----------------------------------------------------------------------------
+
+// Sleeps are used instead of `QTest::qWait`: the flush timer must not run.
+void LoggerTest::checkRateLimit () {
+  Logger::getInstance()->setRateLimits(QStringLiteral(TEST_DOMAIN "=3/%1").arg(TEST_INTERVAL));
+
+  int suppressed;
+  for (int i = 0; i < 3; ++i) {
+    QVERIFY(::checkRateLimit(BCTBX_LOG_MESSAGE, 1, suppressed));
+    QCOMPARE(suppressed, 0);
+  }
+
+  // Burst reached.
+  QVERIFY(!::checkRateLimit(BCTBX_LOG_MESSAGE, 1, suppressed));
+  QVERIFY(!::checkRateLimit(BCTBX_LOG_MESSAGE, 1, suppressed));
+
+  // Other call sites are not affected.
+  QVERIFY(::checkRateLimit(BCTBX_LOG_MESSAGE, 2, suppressed));
+
+  // Next interval: the first message gives the count of the summary.
+  QThread::msleep(TEST_INTERVAL + 50);
+  QVERIFY(::checkRateLimit(BCTBX_LOG_MESSAGE, 1, suppressed));
+  QCOMPARE(suppressed, 2);
+  QVERIFY(::checkRateLimit(BCTBX_LOG_MESSAGE, 1, suppressed));
+  QCOMPARE(suppressed, 0);
+}
+
+void LoggerTest::checkRateLimitFlush () {
+  Logger *logger = Logger::getInstance();
+  logger->setRateLimits(QStringLiteral(TEST_DOMAIN "=1/%1").arg(TEST_INTERVAL));
+
+  int suppressed;
+  QVERIFY(::checkRateLimit(BCTBX_LOG_MESSAGE, 3, suppressed));
+  QVERIFY(!::checkRateLimit(BCTBX_LOG_MESSAGE, 3, suppressed));
+
+  // Not released during its interval.
+  logger->flushRateLimits();
+  QVERIFY(!::checkRateLimit(BCTBX_LOG_MESSAGE, 3, suppressed));
+
+  // Quiet call site: the summary is written by the flush, not by the next message.
+  QThread::msleep(TEST_INTERVAL + 50);
+  logger->flushRateLimits();
+  QVERIFY(::checkRateLimit(BCTBX_LOG_MESSAGE, 3, suppressed));
+  QCOMPARE(suppressed, 0);
+}
+
+void LoggerTest::checkRateLimitLevels () {
+  Logger *logger = Logger::getInstance();
+  logger->setRateLimits(TEST_DOMAIN "=1/10000");
+
+  // Warnings and errors are never limited by default.
+  int suppressed;
+  for (int level : { BCTBX_LOG_WARNING, BCTBX_LOG_ERROR, BCTBX_LOG_FATAL })
+    for (int i = 0; i < 20; ++i)
+      QVERIFY(::checkRateLimit(level, 4, suppressed));
+
+  // Only by the level overrides.
+  logger->setRateLimits(TEST_DOMAIN "=1/10000," TEST_DOMAIN ":warning=2/10000");
+  QVERIFY(::checkRateLimit(BCTBX_LOG_WARNING, 5, suppressed));
+  QVERIFY(::checkRateLimit(BCTBX_LOG_WARNING, 5, suppressed));
+  QVERIFY(!::checkRateLimit(BCTBX_LOG_WARNING, 5, suppressed));
+  for (int i = 0; i < 20; ++i)
+    QVERIFY(::checkRateLimit(BCTBX_LOG_ERROR, 5, suppressed));
+
+  // A burst of 0 disables the limit.
+  logger->setRateLimits(TEST_DOMAIN ":debug=0");
+  for (int i = 0; i < 20; ++i)
+    QVERIFY(::checkRateLimit(BCTBX_LOG_DEBUG, 6, suppressed));
+}
+
+void LoggerTest::checkRateLimitOverrides () {
+  Logger *logger = Logger::getInstance();
+
+  logger->setRateLimits(TEST_DOMAIN "=1/100," TEST_DOMAIN ":info=5/300,*:warning=2/400");
+  QCOMPARE(
+    logger->getRateLimits(),
+    QStringLiteral("*:warning=2/400," TEST_DOMAIN ":message=5/300," TEST_DOMAIN "=1/100")
+  );
+
+  // Invalid entries are ignored.
+  logger->setRateLimits(TEST_DOMAIN "=abc," TEST_DOMAIN ":trace=1/x,=," TEST_DOMAIN ":debug=3/100");
+  QCOMPARE(logger->getRateLimits(), QStringLiteral(TEST_DOMAIN ":debug=3/100"));
+}
+
+// -----------------------------------------------------------------------------
+
+void LoggerTest::checkSetLogLevel () {
+  Logger *logger = Logger::getInstance();
+  QVERIFY(logger->setLogLevels(""));
+
+  QVERIFY(logger->setLogLevel(TEST_DOMAIN, "debug"));
+  QVERIFY(bctbx_log_level_enabled(TEST_DOMAIN, BCTBX_LOG_DEBUG));
+
+  QVERIFY(logger->setLogLevel(TEST_DOMAIN, " Warning "));
+  QVERIFY(!bctbx_log_level_enabled(TEST_DOMAIN, BCTBX_LOG_MESSAGE));
+  QVERIFY(bctbx_log_level_enabled(TEST_DOMAIN, BCTBX_LOG_WARNING));
+
+  // `info` is an alias of `message`.
+  QVERIFY(logger->setLogLevel(TEST_DOMAIN, "info"));
+  QCOMPARE(logger->getLogLevels(), QStringLiteral(TEST_DOMAIN "=message"));
+
+  // Invalid levels and domains are rejected.
+  QVERIFY(!logger->setLogLevel(TEST_DOMAIN, "verbose"));
+  QVERIFY(!logger->setLogLevel(" ", "debug"));
+  QCOMPARE(logger->getLogLevels(), QStringLiteral(TEST_DOMAIN "=message"));
+  QVERIFY(bctbx_log_level_enabled(TEST_DOMAIN, BCTBX_LOG_MESSAGE));
+}
+
+void LoggerTest::checkSetLogLevels () {
+  Logger *logger = Logger::getInstance();
+
+  QVERIFY(logger->setLogLevels("belle-sip=debug, " TEST_DOMAIN "=error"));
+  QCOMPARE(logger->getLogLevels(), QStringLiteral("belle-sip=debug," TEST_DOMAIN "=error"));
+  QVERIFY(bctbx_log_level_enabled("belle-sip", BCTBX_LOG_DEBUG));
+  QVERIFY(!bctbx_log_level_enabled(TEST_DOMAIN, BCTBX_LOG_WARNING));
+
+  // An invalid list is not partially applied.
+  QVERIFY(!logger->setLogLevels(TEST_DOMAIN "=debug,belle-sip=loud"));
+  QVERIFY(!logger->setLogLevels(TEST_DOMAIN));
+  QVERIFY(!logger->setLogLevels("=debug"));
+  QCOMPARE(logger->getLogLevels(), QStringLiteral("belle-sip=debug," TEST_DOMAIN "=error"));
+  QVERIFY(!bctbx_log_level_enabled(TEST_DOMAIN, BCTBX_LOG_WARNING));
+
+  // Unlisted domains are reset to the `*` level.
+  QVERIFY(logger->setLogLevels("*=warning"));
+  QCOMPARE(logger->getLogLevels(), QStringLiteral("*=warning"));
+  QVERIFY(bctbx_log_level_enabled(TEST_DOMAIN, BCTBX_LOG_WARNING));
+  QVERIFY(!bctbx_log_level_enabled(TEST_DOMAIN, BCTBX_LOG_MESSAGE));
+  QVERIFY(!bctbx_log_level_enabled("belle-sip", BCTBX_LOG_MESSAGE));
+
+  // And to the default level without `*`.
+  QVERIFY(logger->setLogLevels(""));
+  QCOMPARE(logger->getLogLevels(), QString());
+  QVERIFY(bctbx_log_level_enabled("belle-sip", BCTBX_LOG_MESSAGE));
+  QVERIFY(!bctbx_log_level_enabled("belle-sip", BCTBX_LOG_TRACE));
+}
+
+void LoggerTest::checkQtFilterRules () {
+  Logger *logger = Logger::getInstance();
+  QLoggingCategory category(TEST_CATEGORY);
+
+  QVERIFY(logger->setLogLevels(TEST_CATEGORY "=warning"));
+  QVERIFY(!category.isDebugEnabled());
+  QVERIFY(!category.isInfoEnabled());
+  QVERIFY(category.isWarningEnabled());
+  QVERIFY(category.isCriticalEnabled());
+
+  // Qt has no trace level, it enables the debug messages.
+  QVERIFY(logger->setLogLevels(TEST_CATEGORY "=trace"));
+  QVERIFY(category.isDebugEnabled());
+  QVERIFY(category.isInfoEnabled());
+
+  QVERIFY(logger->setLogLevels(TEST_CATEGORY "=error"));
+  QVERIFY(!category.isWarningEnabled());
+  QVERIFY(category.isCriticalEnabled());
+
+  // `qt` is the default category, the one of the app messages.
+  QVERIFY(logger->setLogLevels("qt=warning"));
+  QVERIFY(!QLoggingCategory::defaultCategory()->isInfoEnabled());
+  QVERIFY(QLoggingCategory::defaultCategory()->isWarningEnabled());
+  QVERIFY(category.isWarningEnabled());
+}
@@ -27,15 +27,25 @@
 #include "../utils/Utils.hpp"
 
 #include "assistant-view/AssistantViewTest.hpp"
+#include "cli/CliTest.hpp"
+#include "exif-image-header/ExifImageHeaderTest.hpp"
+#include "image-scaler/ImageScalerTest.hpp"
+#include "logger/LoggerTest.hpp"
 #include "main-view/MainViewTest.hpp"
 #include "self-test/SelfTest.hpp"
+#include "svg-template/SvgTemplateTest.hpp"
 
 // =============================================================================
 
 static QHash<QString, QObject *> initializeTests () {
   QHash<QString, QObject *> hash;
   hash["assistant-view"] = new AssistantViewTest();
+  hash["cli"] = new CliTest();
+  hash["exif-image-header"] = new ExifImageHeaderTest();
+  hash["image-scaler"] = new ImageScalerTest();
+  hash["logger"] = new LoggerTest();
   hash["main-view"] = new MainViewTest();
+  hash["svg-template"] = new SvgTemplateTest();
   return hash;
 }
 
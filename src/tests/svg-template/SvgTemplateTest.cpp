@@ -0,0 +1,86 @@
+/*
+ * SvgTemplateTest.cpp
+ * Copyright (C) 2026  Belledonne Communications, Grenoble, France
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *  Created on: October 17, 2026
+ */
+
+#include <QTest>
+
+#include "../../utils/SvgTemplate.hpp"
+
+#include "SvgTemplateTest.hpp"
+
+// =============================================================================
+
+static const QStringList testColorNames = { "g", "i", "k" };
+
+static const char svg[] =
+  "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+  "<!-- <path class=\"color-g-fill\"/> -->\n"
+  "<svg xmlns=\"http://www.w3.org/2000/svg\" viewBox=\"0 0 10 10\">\n"
+  "  <path class=\"shape color-i-fill\" fill=\"#000000\" d=\"M0 0h10v10H0z\"/>\n"
+  "  <g class='color-k-style-stroke color-unknown-fill' style=\"stroke:#000000; opacity:0.5\">\n"
+  "    <circle cx=\"5\" cy=\"5\" r=\"2\"/>\n"
+  "  </g>\n"
+  "</svg>\n";
+
+// Instantiates with the color names as values, e.g. `[i]`.
+static QByteArray instantiateWithNames (const SvgTemplate &svgTemplate) {
+  QVector<QByteArray> colorValues;
+  for (const auto &colorName : svgTemplate.getColorNames())
+    colorValues << "[" + colorName.toLatin1() + "]";
+  return svgTemplate.instantiate(colorValues);
+}
+
+// -----------------------------------------------------------------------------
+
+void SvgTemplateTest::checkCompile () {
+  const SvgTemplate svgTemplate = SvgTemplate::compile(QByteArray(svg), ::testColorNames);
+  QVERIFY(!svgTemplate.isNull());
+  QCOMPARE(svgTemplate.getColorNames(), QStringList({ "i", "k" }));
+
+  const QByteArray content = ::instantiateWithNames(svgTemplate);
+
+  // Comments are copied as is.
+  QVERIFY(content.contains("<!-- <path class=\"color-g-fill\"/> -->"));
+
+  // The fill attribute is replaced.
+  QVERIFY(content.contains("<path fill=\"[i]\" class=\"shape color-i-fill\" d=\"M0 0h10v10H0z\"/>"));
+  QVERIFY(!content.contains("#000000\" d="));
+
+  // The stroke style is replaced, the other declarations are kept.
+  QVERIFY(content.contains("style=\"stroke:[k]; opacity:0.5;\">"));
+  QVERIFY(!content.contains("stroke:#000000"));
+
+  // Unchanged elements.
+  QVERIFY(content.contains("<circle cx=\"5\" cy=\"5\" r=\"2\"/>"));
+
+  // Invalid documents.
+  QVERIFY(SvgTemplate::compile(QByteArray("<svg><path class=\"color-i-fill"), ::testColorNames).isNull());
+  QVERIFY(SvgTemplate::compile(QByteArray("<svg><!-- </svg>"), ::testColorNames).isNull());
+}
+
+void SvgTemplateTest::checkData () {
+  const SvgTemplate svgTemplate = SvgTemplate::compile(QByteArray(svg), ::testColorNames);
+  const SvgTemplate copy = SvgTemplate::fromData(svgTemplate.toData());
+  QVERIFY(!copy.isNull());
+  QCOMPARE(copy.getColorNames(), svgTemplate.getColorNames());
+  QCOMPARE(::instantiateWithNames(copy), ::instantiateWithNames(svgTemplate));
+
+  QVERIFY(SvgTemplate::fromData(QByteArray("invalid")).isNull());
+}
@@ -0,0 +1,578 @@
+/*
+ * main.cpp
+ * Copyright (C) 2026  Belledonne Communications, Grenoble, France
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *  Created on: October 17, 2026
+ */
+
+// Scale testing: writes a profile with a config, a friends database, a message
+// history and call logs, with configurable counts and distributions.
+// Run the app, the tester or the benchmarks on it with the
+// `LINPHONE_PROFILE_DIR=<directory>` environment variable. (See `Paths`.)
+//
+// The databases use the first schemas of liblinphone. The columns added
+// since are created by the core when the profile is opened.
+//
+// The same options give the same profile on every platform: the dates are
+// relative to `--now`, not to the current time, and the random values are
+// drawn from `mt19937` by `Random`. (The `std` distributions are
+// implementation-defined, each standard library has its own results.)
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QTemporaryDir>
+
+#define SIP_DOMAIN "sip.example.org"
+#define LOCAL_SIP_ADDRESS "sip:me@" SIP_DOMAIN
+
+#define CONFIG_FILENAME "linphonerc"
+#define CALL_HISTORY_FILENAME "call-history.db"
+#define FRIENDS_FILENAME "friends.db"
+#define MESSAGE_HISTORY_FILENAME "message-history.db"
+
+// Counts of the 1x dataset, multiplied by the scale.
+#define DEFAULT_CONTACTS 250
+#define DEFAULT_CONVERSATIONS 50
+#define DEFAULT_MESSAGES 2000
+#define DEFAULT_CALLS 1000
+
+#define DEFAULT_SKEW 1.0
+#define DEFAULT_UNKNOWN_RATIO 0.2
+#define DEFAULT_LINK_RATIO 0.05
+#define DEFAULT_DAYS 365
+#define DEFAULT_NOW "2026-01-01T00:00:00Z"
+#define DEFAULT_SEED 42
+
+// In seconds.
+#define MAX_CALL_DURATION 7200
+
+// Values of the core enums, as stored in the databases.
+#define CHAT_MESSAGE_INCOMING 0
+#define CHAT_MESSAGE_OUTGOING 1
+#define CHAT_MESSAGE_STATE_DELIVERED 2
+#define CALL_OUTGOING 0
+#define CALL_INCOMING 1
+#define CALL_STATUS_SUCCESS 0
+#define CALL_STATUS_MISSED 2
+#define SUBSCRIBE_POLICY_ACCEPT 2
+
+using namespace std;
+
+// =============================================================================
+
+namespace {
+  struct Options {
+    int contacts;
+    int conversations;
+    int messages;
+    int calls;
+    double skew;
+    double unknownRatio;
+    double linkRatio;
+    int days;
+    qint64 now; // In seconds since epoch.
+  };
+
+  struct Contact {
+    QString displayName;
+    QString firstName;
+    QString lastName;
+    QString sipAddress;
+  };
+
+  // Only built on the `mt19937` values, which are the same everywhere.
+  class Random {
+  public:
+    Random (quint32 seed) : mGenerator(seed) {}
+
+    // In [min, max].
+    qint64 uniform (qint64 min, qint64 max) {
+      const quint64 range = quint64(max - min) + 1;
+
+      // Rejects the last incomplete range of values, to not favor the first ones.
+      const quint64 limit = (~quint64(0) / range) * range;
+      quint64 value;
+      do
+        value = (quint64(mGenerator()) << 32) | mGenerator();
+      while (value >= limit);
+
+      return min + qint64(value % range);
+    }
+
+    // In [0, 1), 53 bits.
+    double real () {
+      const quint32 a = quint32(mGenerator() >> 5);
+      const quint32 b = quint32(mGenerator() >> 6);
+      return (a * 67108864.0 + b) / 9007199254740992.0;
+    }
+
+    bool bernoulli (double probability) {
+      return real() < probability;
+    }
+
+    // Failures before the first success, capped to `max`.
+    int geometric (double probability, int max) {
+      int count = 0;
+      while (count < max && !bernoulli(probability))
+        ++count;
+      return count;
+    }
+
+    template<typename T>
+    void shuffle (T &container) {
+      for (int i = int(container.size()) - 1; i > 0; --i)
+        std::swap(container[i], container[int(uniform(0, i))]);
+    }
+
+  private:
+    mt19937 mGenerator;
+  };
+
+  // Index picked with a probability proportional to its weight.
+  class DiscreteDistribution {
+  public:
+    DiscreteDistribution (const vector<double> &weights) {
+      double sum = 0.0;
+      mCumulativeWeights.reserve(weights.size());
+      for (double weight : weights)
+        mCumulativeWeights.push_back(sum += weight);
+    }
+
+    int operator() (Random &random) const {
+      if (mCumulativeWeights.empty())
+        return 0;
+
+      const double value = random.real() * mCumulativeWeights.back();
+      const auto it = upper_bound(mCumulativeWeights.cbegin(), mCumulativeWeights.cend(), value);
+      return int(min(it - mCumulativeWeights.cbegin(), ptrdiff_t(mCumulativeWeights.size()) - 1));
+    }
+
+  private:
+    vector<double> mCumulativeWeights;
+  };
+}
+
+static const char *firstNames[] = {
+  "Alice", "Bob", "Camille", "David", "Emma", "François", "Gabriel", "Hélène", "Igor", "Jeanne",
+  "Kevin", "Léa", "Marc", "Nora", "Olivier", "Paul", "Quentin", "Rose", "Sophie", "Thomas"
+};
+
+static const char *lastNames[] = {
+  "Martin", "Bernard", "Dubois", "Thomas", "Robert", "Richard", "Petit", "Durand", "Leroy", "Moreau",
+  "Simon", "Laurent", "Lefebvre", "Michel", "Garcia", "David", "Bertrand", "Roux", "Vincent", "Fournier"
+};
+
+static const char *words[] = {
+  "hello", "call", "me", "when", "you", "can", "the", "meeting", "is", "at", "noon", "tomorrow",
+  "ok", "thanks", "see", "later", "I", "am", "on", "my", "way", "did", "send", "file", "yes",
+  "no", "maybe", "sounds", "good", "😀", "👍", "project", "review", "done", ":)", "?"
+};
+
+template<typename T, size_t N>
+static inline int countOf (T (&)[N]) {
+  return int(N);
+}
+
+// -----------------------------------------------------------------------------
+
+static QVector<Contact> createContacts (Random &random, int count) {
+  QVector<Contact> contacts;
+  contacts.reserve(count);
+  for (int i = 0; i < count; ++i) {
+    Contact contact;
+    contact.firstName = QString::fromUtf8(firstNames[random.uniform(0, ::countOf(firstNames) - 1)]);
+    contact.lastName = QString::fromUtf8(lastNames[random.uniform(0, ::countOf(lastNames) - 1)]);
+    contact.displayName = contact.firstName + " " + contact.lastName;
+    contact.sipAddress = QStringLiteral("sip:%1.%2.%3@" SIP_DOMAIN)
+      .arg(contact.firstName.toLower()).arg(contact.lastName.toLower()).arg(i);
+    contacts << contact;
+  }
+
+  return contacts;
+}
+
+// Peers of the conversations and calls: contacts and unknown addresses, shuffled.
+static QStringList createPeers (Random &random, const QVector<Contact> &contacts, double unknownRatio) {
+  QStringList peers;
+  for (const auto &contact : contacts)
+    peers << contact.sipAddress;
+
+  const int unknownCount = int(std::lround(contacts.size() * unknownRatio));
+  for (int i = 0; i < unknownCount; ++i)
+    peers << QStringLiteral("sip:unknown.%1@" SIP_DOMAIN).arg(i);
+
+  random.shuffle(peers);
+  return peers;
+}
+
+// Few peers have most of the messages and calls, like in real profiles.
+// With a skew other than 1, the weights depend on `pow`, which may differ by
+// one ulp between C libraries: a peer picked at the very edge of its weight
+// could change.
+static DiscreteDistribution createZipfDistribution (int count, double skew) {
+  vector<double> weights;
+  weights.reserve(size_t(count));
+  for (int rank = 1; rank <= count; ++rank)
+    weights.push_back(1.0 / pow(rank, skew));
+  return DiscreteDistribution(weights);
+}
+
+// Sorted dates, in seconds since epoch, over the days before `now`.
+static QVector<qint64> createDates (Random &random, int count, int days, qint64 now) {
+  QVector<qint64> dates;
+  dates.reserve(count);
+  for (int i = 0; i < count; ++i)
+    dates << random.uniform(now - qint64(days) * 24 * 3600, now);
+  sort(dates.begin(), dates.end());
+
+  return dates;
+}
+
+static QString createMessageText (Random &random, double linkRatio) {
+  QStringList text;
+  for (int i = 0, length = 1 + random.geometric(0.15, 200); i < length; ++i)
+    text << QString::fromUtf8(words[random.uniform(0, ::countOf(words) - 1)]);
+  if (random.bernoulli(linkRatio))
+    text << QStringLiteral("https://www.linphone.org/");
+
+  return text.join(' ');
+}
+
+// -----------------------------------------------------------------------------
+
+static bool exec (QSqlQuery &query) {
+  if (query.exec())
+    return true;
+
+  qWarning() << QStringLiteral("Unable to execute query: `%1`.").arg(query.lastError().text());
+  return false;
+}
+
+static bool exec (QSqlDatabase &database, const QString &statement) {
+  QSqlQuery query(database);
+  if (query.exec(statement))
+    return true;
+
+  qWarning() << QStringLiteral("Unable to execute statement: `%1`.").arg(query.lastError().text());
+  return false;
+}
+
+// Opens a new database, in a transaction committed by `closeDatabase`.
+static bool openDatabase (QSqlDatabase &database, const QString &path, const QString &schema) {
+  QFile::remove(path);
+
+  database = QSqlDatabase::addDatabase("QSQLITE", path);
+  database.setDatabaseName(path);
+  if (!database.open()) {
+    qWarning() << QStringLiteral("Unable to open database: `%1`.").arg(path);
+    return false;
+  }
+
+  for (const auto &statement : schema.split(';', QString::SkipEmptyParts))
+    if (!statement.trimmed().isEmpty() && !::exec(database, statement))
+      return false;
+
+  return database.transaction();
+}
+
+static bool closeDatabase (QSqlDatabase &database, bool status) {
+  const QString name = database.connectionName();
+
+  status = status && database.commit();
+  database.close();
+  database = QSqlDatabase();
+  QSqlDatabase::removeDatabase(name);
+
+  return status;
+}
+
+// -----------------------------------------------------------------------------
+
+static bool writeFriends (const QString &path, const QVector<Contact> &contacts) {
+  QSqlDatabase database;
+  bool status = ::openDatabase(database, path, QStringLiteral(
+    "CREATE TABLE friends ("
+    "  id INTEGER PRIMARY KEY AUTOINCREMENT,"
+    "  friend_list_id INTEGER,"
+    "  sip_uri TEXT NOT NULL,"
+    "  subscribe_policy INTEGER,"
+    "  send_subscribe INTEGER,"
+    "  ref_key TEXT,"
+    "  vCard TEXT,"
+    "  vCard_etag TEXT,"
+    "  vCard_url TEXT,"
+    "  presence_received INTEGER"
+    ");"
+    "CREATE TABLE friends_lists ("
+    "  id INTEGER PRIMARY KEY AUTOINCREMENT,"
+    "  display_name TEXT,"
+    "  rls_uri TEXT,"
+    "  uri TEXT,"
+    "  revision INTEGER"
+    ");"
+    "INSERT INTO friends_lists (id, display_name, revision) VALUES (1, 'Default', 0);"
+  ));
+
+  if (status) {
+    QSqlQuery query(database);
+    query.prepare(
+      "INSERT INTO friends (friend_list_id, sip_uri, subscribe_policy, send_subscribe, vCard, presence_received)"
+      " VALUES (1, ?, " + QString::number(SUBSCRIBE_POLICY_ACCEPT) + ", 0, ?, 0)"
+    );
+
+    for (int i = 0; status && i < contacts.size(); ++i) {
+      const Contact &contact = contacts[i];
+      query.addBindValue(contact.sipAddress);
+      query.addBindValue(QStringLiteral(
+        "BEGIN:VCARD\r\n"
+        "VERSION:4.0\r\n"
+        "FN:%1\r\n"
+        "N:%2;%3;;;\r\n"
+        "IMPP:%4\r\n"
+        "END:VCARD\r\n"
+      ).arg(contact.displayName).arg(contact.lastName).arg(contact.firstName).arg(contact.sipAddress));
+      status = ::exec(query);
+    }
+  }
+
+  return ::closeDatabase(database, status);
+}
+
+static bool writeMessages (const QString &path, Random &random, const QStringList &peers, const Options &options) {
+  QSqlDatabase database;
+  bool status = ::openDatabase(database, path, QStringLiteral(
+    "CREATE TABLE history ("
+    "  id INTEGER PRIMARY KEY AUTOINCREMENT,"
+    "  localContact TEXT NOT NULL,"
+    "  remoteContact TEXT NOT NULL,"
+    "  direction INTEGER,"
+    "  message TEXT,"
+    "  time TEXT NOT NULL,"
+    "  read INTEGER,"
+    "  status INTEGER,"
+    "  url TEXT,"
+    "  utc INTEGER"
+    ");"
+  ));
+
+  if (status) {
+    const DiscreteDistribution peerDistribution = ::createZipfDistribution(
+      qMin(options.conversations, peers.size()), options.skew
+    );
+
+    // Only the incoming messages of the last day are unread.
+    const qint64 unreadDate = options.now - 24 * 3600;
+
+    QSqlQuery query(database);
+    query.prepare(
+      "INSERT INTO history (localContact, remoteContact, direction, message, time, read, status, utc)"
+      " VALUES ('" LOCAL_SIP_ADDRESS "', ?, ?, ?, '-1', ?, " + QString::number(CHAT_MESSAGE_STATE_DELIVERED) + ", ?)"
+    );
+
+    for (const auto &date : ::createDates(random, options.messages, options.days, options.now)) {
+      const bool incoming = random.bernoulli(0.5);
+      query.addBindValue(peers[peerDistribution(random)]);
+      query.addBindValue(incoming ? CHAT_MESSAGE_INCOMING : CHAT_MESSAGE_OUTGOING);
+      query.addBindValue(::createMessageText(random, options.linkRatio));
+      query.addBindValue((!incoming || date < unreadDate) ? 1 : 0);
+      query.addBindValue(date);
+      if (!(status = ::exec(query)))
+        break;
+    }
+  }
+
+  return ::closeDatabase(database, status);
+}
+
+static bool writeCalls (const QString &path, Random &random, const QStringList &peers, const Options &options) {
+  QSqlDatabase database;
+  bool status = ::openDatabase(database, path, QStringLiteral(
+    "CREATE TABLE call_history ("
+    "  id INTEGER PRIMARY KEY AUTOINCREMENT,"
+    "  caller TEXT NOT NULL,"
+    "  callee TEXT NOT NULL,"
+    "  direction INTEGER,"
+    "  duration INTEGER,"
+    "  start_time TEXT NOT NULL,"
+    "  connected_time TEXT NOT NULL,"
+    "  status INTEGER,"
+    "  videoEnabled INTEGER,"
+    "  quality REAL"
+    ");"
+  ));
+
+  if (status) {
+    const DiscreteDistribution peerDistribution = ::createZipfDistribution(peers.size(), options.skew);
+
+    QSqlQuery query(database);
+    query.prepare(
+      "INSERT INTO call_history (caller, callee, direction, duration, start_time, connected_time, status, videoEnabled, quality)"
+      " VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)"
+    );
+
+    for (const auto &date : ::createDates(random, options.calls, options.days, options.now)) {
+      const QString &peer = peers[peerDistribution(random)];
+      const bool incoming = random.bernoulli(0.5);
+      const bool missed = incoming && random.bernoulli(0.2);
+
+      query.addBindValue(incoming ? peer : QStringLiteral(LOCAL_SIP_ADDRESS));
+      query.addBindValue(incoming ? QStringLiteral(LOCAL_SIP_ADDRESS) : peer);
+      query.addBindValue(incoming ? CALL_INCOMING : CALL_OUTGOING);
+      // About 3 minutes on average, drawn second by second.
+      query.addBindValue(missed ? 0 : 1 + random.geometric(1.0 / 180, MAX_CALL_DURATION));
+      query.addBindValue(QString::number(date));
+      query.addBindValue(QString::number(missed ? 0 : date + 2));
+      query.addBindValue(missed ? CALL_STATUS_MISSED : CALL_STATUS_SUCCESS);
+      query.addBindValue(random.bernoulli(0.1) ? 1 : 0);
+      query.addBindValue(missed ? -1.0 : 4.0);
+      if (!(status = ::exec(query)))
+        break;
+    }
+  }
+
+  return ::closeDatabase(database, status);
+}
+
+// Written last: its presence means the profile is complete.
+static bool writeConfig (const QString &path) {
+  QSaveFile file(path);
+  if (
+    file.open(QIODevice::WriteOnly | QIODevice::Text) &&
+    file.write(
+      "[sip]\n"
+      "contact=\"Me\" <" LOCAL_SIP_ADDRESS ">\n"
+      "sip_port=-1\n"
+      "\n"
+      "[misc]\n"
+      "store_friends=1\n"
+    ) > 0 &&
+    file.commit()
+  )
+    return true;
+
+  qWarning() << QStringLiteral("Unable to write file: `%1`.").arg(path);
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+
+int main (int argc, char *argv[]) {
+  QCoreApplication app(argc, argv);
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Generate a profile with many contacts, messages and call logs.");
+  parser.addHelpOption();
+  parser.addOptions({
+    { "scale", "Multiply the default counts. (1, 10, 100...)", "factor", "1" },
+    { "contacts", "Contacts count. (Default: " + QString::number(DEFAULT_CONTACTS) + " x scale)", "count" },
+    { "conversations", "Conversations count. (Default: " + QString::number(DEFAULT_CONVERSATIONS) + " x scale)", "count" },
+    { "messages", "Messages count. (Default: " + QString::number(DEFAULT_MESSAGES) + " x scale)", "count" },
+    { "calls", "Call logs count. (Default: " + QString::number(DEFAULT_CALLS) + " x scale)", "count" },
+    { "skew", "Exponent of the Zipf distribution of the messages and calls per peer.", "exponent", QString::number(DEFAULT_SKEW) },
+    { "unknown-ratio", "Peers which are not contacts, relative to the contacts count.", "ratio", QString::number(DEFAULT_UNKNOWN_RATIO) },
+    { "link-ratio", "Messages containing a link.", "ratio", QString::number(DEFAULT_LINK_RATIO) },
+    { "days", "History duration.", "days", QString::number(DEFAULT_DAYS) },
+    { "now", "Date of the last messages and calls, in seconds since epoch or ISO 8601. (UTC if no offset)", "date", DEFAULT_NOW },
+    { "seed", "Random seed. The same seed gives the same profile.", "seed", QString::number(DEFAULT_SEED) }
+  });
+  parser.addPositionalArgument("directory", "Profile directory. (Default: a new temporary directory)", "[directory]");
+  parser.process(app);
+
+  const int scale = qMax(1, parser.value("scale").toInt());
+  const auto getCount = [&parser, scale](const QString &name, int defaultCount) {
+    return parser.isSet(name) ? qMax(0, parser.value(name).toInt()) : defaultCount * scale;
+  };
+
+  Options options;
+  options.contacts = getCount("contacts", DEFAULT_CONTACTS);
+  options.conversations = getCount("conversations", DEFAULT_CONVERSATIONS);
+  options.messages = getCount("messages", DEFAULT_MESSAGES);
+  options.calls = getCount("calls", DEFAULT_CALLS);
+  options.skew = parser.value("skew").toDouble();
+  options.unknownRatio = qBound(0.0, parser.value("unknown-ratio").toDouble(), 10.0);
+  options.linkRatio = qBound(0.0, parser.value("link-ratio").toDouble(), 1.0);
+  options.days = qMax(1, parser.value("days").toInt());
+
+  {
+    const QString now = parser.value("now");
+    bool ok;
+    options.now = now.toLongLong(&ok);
+    if (!ok) {
+      QDateTime dateTime = QDateTime::fromString(now, Qt::ISODate);
+      if (!dateTime.isValid()) {
+        qWarning() << QStringLiteral("Unable to parse date: `%1`.").arg(now);
+        return EXIT_FAILURE;
+      }
+      if (dateTime.timeSpec() == Qt::LocalTime)
+        dateTime.setTimeSpec(Qt::UTC);
+      options.now = dateTime.toMSecsSinceEpoch() / 1000;
+    }
+  }
+
+  QString dirPath;
+  if (!parser.positionalArguments().isEmpty())
+    dirPath = QDir(parser.positionalArguments().first()).absolutePath();
+  else {
+    QTemporaryDir temporaryDir(QDir::tempPath() + "/linphone-dataset-XXXXXX");
+    temporaryDir.setAutoRemove(false);
+    dirPath = temporaryDir.path();
+  }
+
+  const QDir dir(dirPath);
+  if (dirPath.isEmpty() || !dir.mkpath(".")) {
+    qWarning() << QStringLiteral("Unable to create profile directory: `%1`.").arg(dirPath);
+    return EXIT_FAILURE;
+  }
+  QFile::remove(dir.filePath(CONFIG_FILENAME));
+
+  Random random(parser.value("seed").toUInt());
+  const QVector<Contact> contacts = ::createContacts(random, options.contacts);
+  const QStringList peers = ::createPeers(random, contacts, options.unknownRatio);
+  if (peers.isEmpty() && (options.messages || options.calls)) {
+    qWarning() << QStringLiteral("Unable to create messages or calls without contacts and unknown peers.");
+    return EXIT_FAILURE;
+  }
+
+  if (
+    !::writeFriends(dir.filePath(FRIENDS_FILENAME), contacts) ||
+    !::writeMessages(dir.filePath(MESSAGE_HISTORY_FILENAME), random, peers, options) ||
+    !::writeCalls(dir.filePath(CALL_HISTORY_FILENAME), random, peers, options) ||
+    !::writeConfig(dir.filePath(CONFIG_FILENAME))
+  )
+    return EXIT_FAILURE;
+
+  qInfo() << QStringLiteral("Profile written in `%1`: %2 contacts, %3 messages, %4 calls.")
+    .arg(dirPath).arg(options.contacts).arg(options.messages).arg(options.calls);
+
+  // Printed alone on stdout, for scripts.
+  printf("%s\n", qPrintable(dirPath));
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,185 @@
+/*
+ * main.cpp
+ * Copyright (C) 2026  Belledonne Communications, Grenoble, France
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *  Created on: October 17, 2026
+ */
+
+// Build step: compiles the svg images into templates (see `SvgTemplate`)
+// and rasterizes the most used small icons in an atlas (see `ImageAtlas`)
+// with the default colors declared in `Colors.hpp`.
+
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFileInfo>
+#include <QGuiApplication>
+#include <QPainter>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QSvgRenderer>
+
+#include "../../utils/ImageAtlas.hpp"
+#include "../../utils/SvgTemplate.hpp"
+
+#define TEMPLATES_DIRNAME "templates"
+#define ATLAS_FILENAME "atlas"
+
+// Bigger images are not added in the atlas.
+#define ATLAS_MAX_IMAGE_SIZE 64
+
+using namespace std;
+
+// =============================================================================
+
+// Parses the `ADD_COLOR` and `ADD_COLOR_WITH_ALPHA` declarations.
+// Alpha is not used by the svg values. (`#rrggbb`)
+static QMap<QString, QString> parseDefaultColors (const QString &path) {
+  QFile file(path);
+  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    qWarning() << QStringLiteral("Unable to open colors file: `%1`.").arg(path);
+    return QMap<QString, QString>();
+  }
+
+  static const QRegularExpression colorRegex("^\\s*ADD_COLOR\\((\\w+),\\s*\"([^\"]*)\"\\)");
+  static const QRegularExpression alphaRegex("^\\s*ADD_COLOR_WITH_ALPHA\\((\\w+),\\s*(\\d+)\\)");
+
+  QMap<QString, QString> colors;
+  while (!file.atEnd()) {
+    const QString line = QString::fromUtf8(file.readLine());
+
+    QRegularExpressionMatch match = colorRegex.match(line);
+    if (match.hasMatch()) {
+      colors[match.captured(1)] = QColor(match.captured(2)).name();
+      continue;
+    }
+
+    match = alphaRegex.match(line);
+    if (match.hasMatch())
+      colors[match.captured(1) + match.captured(2)] = colors.value(match.captured(1));
+  }
+
+  return colors;
+}
+
+static bool writeFile (const QString &path, const QByteArray &data) {
+  QSaveFile file(path);
+  if (file.open(QIODevice::WriteOnly) && file.write(data) == data.size() && file.commit())
+    return true;
+
+  qWarning() << QStringLiteral("Unable to write file: `%1`.").arg(path);
+  return false;
+}
+
+static QImage rasterize (const SvgTemplate &svgTemplate, const QMap<QString, QString> &colors) {
+  QVector<QByteArray> colorValues;
+  for (const auto &colorName : svgTemplate.getColorNames())
+    colorValues << colors.value(colorName).toLatin1();
+
+  QSvgRenderer renderer(svgTemplate.instantiate(colorValues));
+  if (!renderer.isValid())
+    return QImage();
+
+  // Same size as `ImageProvider` without requested size.
+  const QRectF viewBox = renderer.viewBoxF();
+  QImage image(static_cast<int>(viewBox.width()), static_cast<int>(viewBox.height()), QImage::Format_ARGB32);
+  if (image.isNull())
+    return QImage();
+  image.fill(0x00000000);
+
+  QPainter painter(&image);
+  renderer.render(&painter);
+
+  return image;
+}
+
+// -----------------------------------------------------------------------------
+
+int main (int argc, char *argv[]) {
+  // Rasterization without display.
+  if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+
+  QGuiApplication app(argc, argv);
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Compile svg images into templates and an icons atlas.");
+  parser.addHelpOption();
+  parser.addOptions({
+    { "colors", "Header declaring the colors.", "file" },
+    { "output", "Output directory.", "directory" },
+    { "atlas", "Comma separated images to add in the atlas. (Without extension)", "names" }
+  });
+  parser.addPositionalArgument("images", "Svg files.", "images...");
+  parser.process(app);
+
+  if (!parser.isSet("colors") || !parser.isSet("output")) {
+    parser.showHelp(EXIT_FAILURE);
+    return EXIT_FAILURE;
+  }
+
+  const QMap<QString, QString> colors = ::parseDefaultColors(parser.value("colors"));
+  if (colors.isEmpty())
+    return EXIT_FAILURE;
+
+  const QDir outputDir(parser.value("output"));
+  if (!outputDir.mkpath(TEMPLATES_DIRNAME)) {
+    qWarning() << QStringLiteral("Unable to create output directory: `%1`.").arg(outputDir.path());
+    return EXIT_FAILURE;
+  }
+
+  const QStringList atlasNames = parser.value("atlas").split(',', QString::SkipEmptyParts);
+
+  QHash<QString, QImage> atlasImages;
+  QMap<QString, QString> atlasColors;
+
+  for (const auto &path : parser.positionalArguments()) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+      qWarning() << QStringLiteral("Unable to open file: `%1`.").arg(path);
+      return EXIT_FAILURE;
+    }
+
+    const SvgTemplate svgTemplate = SvgTemplate::compile(file, colors.keys());
+    if (svgTemplate.isNull()) {
+      qWarning() << QStringLiteral("Unable to parse file: `%1`.").arg(path);
+      return EXIT_FAILURE;
+    }
+
+    const QFileInfo info(path);
+    const QString templatePath = outputDir.filePath(QStringLiteral(TEMPLATES_DIRNAME "/") + info.fileName());
+    if (!::writeFile(templatePath, svgTemplate.toData()))
+      return EXIT_FAILURE;
+
+    if (!atlasNames.contains(info.completeBaseName()))
+      continue;
+
+    const QImage image = ::rasterize(svgTemplate, colors);
+    if (image.isNull() || image.width() > ATLAS_MAX_IMAGE_SIZE || image.height() > ATLAS_MAX_IMAGE_SIZE) {
+      qWarning() << QStringLiteral("Image not added in atlas: `%1`.").arg(path);
+      continue;
+    }
+
+    atlasImages[info.fileName()] = image;
+    for (const auto &colorName : svgTemplate.getColorNames())
+      atlasColors[colorName] = colors[colorName];
+  }
+
+  // Always written, even if empty: it's a build output.
+  return ::writeFile(outputDir.filePath(ATLAS_FILENAME), ImageAtlas::toData(atlasImages, atlasColors))
+    ? EXIT_SUCCESS
+    : EXIT_FAILURE;
+}
@@ -0,0 +1,154 @@
+/*
+ * ImageAtlas.cpp
+ * Copyright (C) 2026  Belledonne Communications, Grenoble, France
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *  Created on: October 17, 2026
+ */
+
+#include <algorithm>
+
+#include <QDataStream>
+#include <QPainter>
+
+#include "ImageAtlas.hpp"
+
+// Must be incremented when the binary form changes.
+#define IMAGE_ATLAS_VERSION 1
+#define IMAGE_ATLAS_MAGIC 0x4C41544C // "LATL"
+
+#define ATLAS_WIDTH 256
+#define ATLAS_PADDING 1
+
+// Pixels offset alignment.
+#define ATLAS_ALIGNMENT 16
+
+using namespace std;
+
+// =============================================================================
+
+static int align (int value) {
+  return (value + ATLAS_ALIGNMENT - 1) / ATLAS_ALIGNMENT * ATLAS_ALIGNMENT;
+}
+
+QImage ImageAtlas::getImage (const QString &id) const {
+  auto it = mRects.constFind(id);
+  if (it == mRects.cend())
+    return QImage();
+
+  const QRect &rect = *it;
+
+  // Const data: a write on the returned image detaches it.
+  return QImage(
+    mImage.constBits() + rect.y() * mImage.bytesPerLine() + rect.x() * 4,
+    rect.width(),
+    rect.height(),
+    mImage.bytesPerLine(),
+    QImage::Format_ARGB32
+  );
+}
+
+// -----------------------------------------------------------------------------
+
+ImageAtlas ImageAtlas::fromData (const QByteArray &data) {
+  QDataStream stream(data);
+  stream.setVersion(QDataStream::Qt_5_0);
+
+  quint32 magic, version;
+  stream >> magic >> version;
+  if (magic != IMAGE_ATLAS_MAGIC || version != IMAGE_ATLAS_VERSION)
+    return ImageAtlas();
+
+  ImageAtlas atlas;
+
+  qint32 width, height, bytesPerLine;
+  stream >> width >> height >> bytesPerLine >> atlas.mRects >> atlas.mColors;
+  if (stream.status() != QDataStream::Ok)
+    return ImageAtlas();
+
+  const int offset = ::align(static_cast<int>(stream.device()->pos()));
+  if (
+    width <= 0 || height <= 0 || bytesPerLine < width * 4 ||
+    data.size() != offset + bytesPerLine * height
+  )
+    return ImageAtlas();
+
+  const QRect bounds(0, 0, width, height);
+  for (const auto &rect : atlas.mRects)
+    if (!bounds.contains(rect))
+      return ImageAtlas();
+
+  // No copy, the image uses the given data.
+  atlas.mData = data;
+  atlas.mImage = QImage(
+    reinterpret_cast<const uchar *>(atlas.mData.constData()) + offset,
+    width,
+    height,
+    bytesPerLine,
+    QImage::Format_ARGB32
+  );
+
+  return atlas;
+}
+
+QByteArray ImageAtlas::toData (const QHash<QString, QImage> &images, const QMap<QString, QString> &colors) {
+  // 1. Shelf packing, tallest images first.
+  QStringList ids = images.keys();
+  sort(ids.begin(), ids.end(), [&images](const QString &a, const QString &b) {
+    const int heightA = images[a].height();
+    const int heightB = images[b].height();
+    return heightA != heightB ? heightA > heightB : a < b;
+  });
+
+  QHash<QString, QRect> rects;
+  int x = 0, y = 0, shelfHeight = 0;
+  for (const auto &id : ids) {
+    const QImage &image = images[id];
+    if (x + image.width() > ATLAS_WIDTH) {
+      x = 0;
+      y += shelfHeight + ATLAS_PADDING;
+      shelfHeight = 0;
+    }
+
+    rects[id] = QRect(x, y, image.width(), image.height());
+    x += image.width() + ATLAS_PADDING;
+    shelfHeight = qMax(shelfHeight, image.height());
+  }
+
+  // 2. Paint.
+  QImage atlas(ATLAS_WIDTH, qMax(y + shelfHeight, 1), QImage::Format_ARGB32);
+  atlas.fill(0x00000000);
+  {
+    QPainter painter(&atlas);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    for (auto it = rects.cbegin(); it != rects.cend(); ++it)
+      painter.drawImage(it->topLeft(), images[it.key()].convertToFormat(QImage::Format_ARGB32));
+  }
+
+  // 3. Header, then raw pixels.
+  QByteArray data;
+  QDataStream stream(&data, QIODevice::WriteOnly);
+  stream.setVersion(QDataStream::Qt_5_0);
+
+  stream << quint32(IMAGE_ATLAS_MAGIC) << quint32(IMAGE_ATLAS_VERSION);
+  stream << qint32(atlas.width()) << qint32(atlas.height()) << qint32(atlas.bytesPerLine());
+  stream << rects << colors;
+
+  data.append(QByteArray(::align(data.size()) - data.size(), '\0'));
+  data.append(reinterpret_cast<const char *>(atlas.constBits()), atlas.bytesPerLine() * atlas.height());
+
+  return data;
+}
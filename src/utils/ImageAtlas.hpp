@@ -0,0 +1,60 @@
+/*
+ * ImageAtlas.hpp
+ * Copyright (C) 2026  Belledonne Communications, Grenoble, France
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *  Created on: October 17, 2026
+ */
+
+#ifndef IMAGE_ATLAS_H_
+#define IMAGE_ATLAS_H_
+
+#include <QHash>
+#include <QImage>
+#include <QMap>
+
+// =============================================================================
+
+// Small images rasterized in one ARGB32 image. Built by the images compiler
+// with the default colors and embedded in the resources.
+class ImageAtlas {
+public:
+  ImageAtlas () = default;
+
+  bool isNull () const {
+    return mImage.isNull();
+  }
+
+  // Colors used by the atlas images. Name => `#rrggbb`.
+  const QMap<QString, QString> &getColors () const {
+    return mColors;
+  }
+
+  // Returns a null image if `id` is not in the atlas.
+  // The returned image shares the atlas memory.
+  QImage getImage (const QString &id) const;
+
+  static ImageAtlas fromData (const QByteArray &data);
+  static QByteArray toData (const QHash<QString, QImage> &images, const QMap<QString, QString> &colors);
+
+private:
+  QByteArray mData;
+  QImage mImage;
+  QHash<QString, QRect> mRects;
+  QMap<QString, QString> mColors;
+};
+
+#endif // IMAGE_ATLAS_H_
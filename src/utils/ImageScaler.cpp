@@ -0,0 +1,213 @@
+/*
+ * ImageScaler.cpp
+ * Copyright (C) 2026  Belledonne Communications, Grenoble, France
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *  Created on: October 17, 2026
+ */
+
+#include <algorithm>
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #include <immintrin.h>
+  #define IMAGE_SCALER_SSE2
+  // Without AVX2 at compile time, detected at runtime with gcc and clang.
+  #if defined(__AVX2__) || (defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)))
+    #define IMAGE_SCALER_AVX2
+  #endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+  #include <arm_neon.h>
+  #define IMAGE_SCALER_NEON
+#endif
+
+#include "ImageScaler.hpp"
+
+// The vertical sums are stored on 16 bits: 255 * 257 < 65536. The last
+// blocks have less than twice the factor rows.
+#define MAX_BOX_FACTOR 128
+
+using namespace std;
+
+// =============================================================================
+
+// Adds `size` bytes of `row` to the 16 bits accumulators.
+typedef void (*AccumulateRow)(quint16 *acc, const uchar *row, int size);
+
+static inline void accumulateRowScalar (quint16 *acc, const uchar *row, int size, int start) {
+  for (int i = start; i < size; ++i)
+    acc[i] = quint16(acc[i] + row[i]);
+}
+
+#if !defined(IMAGE_SCALER_SSE2) && !defined(IMAGE_SCALER_NEON)
+  static void accumulateRowScalar (quint16 *acc, const uchar *row, int size) {
+    ::accumulateRowScalar(acc, row, size, 0);
+  }
+#endif // if !defined(IMAGE_SCALER_SSE2) && !defined(IMAGE_SCALER_NEON)
+
+#ifdef IMAGE_SCALER_SSE2
+  static void accumulateRowSse2 (quint16 *acc, const uchar *row, int size) {
+    const __m128i zero = _mm_setzero_si128();
+
+    int i = 0;
+    for (; i + 16 <= size; i += 16) {
+      const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + i));
+      __m128i *dest = reinterpret_cast<__m128i *>(acc + i);
+      _mm_storeu_si128(dest, _mm_add_epi16(_mm_loadu_si128(dest), _mm_unpacklo_epi8(pixels, zero)));
+      _mm_storeu_si128(dest + 1, _mm_add_epi16(_mm_loadu_si128(dest + 1), _mm_unpackhi_epi8(pixels, zero)));
+    }
+
+    ::accumulateRowScalar(acc, row, size, i);
+  }
+#endif // ifdef IMAGE_SCALER_SSE2
+
+#ifdef IMAGE_SCALER_AVX2
+  #ifndef __AVX2__
+    __attribute__((target("avx2")))
+  #endif // ifndef __AVX2__
+  static void accumulateRowAvx2 (quint16 *acc, const uchar *row, int size) {
+    int i = 0;
+    for (; i + 32 <= size; i += 32) {
+      const __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row + i));
+      __m256i *dest = reinterpret_cast<__m256i *>(acc + i);
+      _mm256_storeu_si256(dest, _mm256_add_epi16(
+        _mm256_loadu_si256(dest), _mm256_cvtepu8_epi16(_mm256_castsi256_si128(pixels))
+      ));
+      _mm256_storeu_si256(dest + 1, _mm256_add_epi16(
+        _mm256_loadu_si256(dest + 1), _mm256_cvtepu8_epi16(_mm256_extracti128_si256(pixels, 1))
+      ));
+    }
+
+    ::accumulateRowScalar(acc, row, size, i);
+  }
+#endif // ifdef IMAGE_SCALER_AVX2
+
+#ifdef IMAGE_SCALER_NEON
+  static void accumulateRowNeon (quint16 *acc, const uchar *row, int size) {
+    int i = 0;
+    for (; i + 16 <= size; i += 16) {
+      const uint8x16_t pixels = vld1q_u8(row + i);
+      vst1q_u16(acc + i, vaddw_u8(vld1q_u16(acc + i), vget_low_u8(pixels)));
+      vst1q_u16(acc + i + 8, vaddw_u8(vld1q_u16(acc + i + 8), vget_high_u8(pixels)));
+    }
+
+    ::accumulateRowScalar(acc, row, size, i);
+  }
+#endif // ifdef IMAGE_SCALER_NEON
+
+static AccumulateRow getAccumulateRow () {
+  #ifdef IMAGE_SCALER_AVX2
+    #ifdef __AVX2__
+      return ::accumulateRowAvx2;
+    #else
+      if (__builtin_cpu_supports("avx2"))
+        return ::accumulateRowAvx2;
+    #endif // ifdef __AVX2__
+  #endif // ifdef IMAGE_SCALER_AVX2
+
+  #if defined(IMAGE_SCALER_SSE2)
+    return ::accumulateRowSse2;
+  #elif defined(IMAGE_SCALER_NEON)
+    return ::accumulateRowNeon;
+  #else
+    return ::accumulateRowScalar;
+  #endif // if defined(IMAGE_SCALER_SSE2)
+}
+
+// Sums each block of `factor` pixels (4 channels) and divides it by the block
+// size. The last block also takes the `remainder` pixels of the row.
+static void reduceRow (const quint16 *acc, uchar *dest, int width, int factor, int remainder, int rows) {
+  for (int x = 0; x < width; ++x) {
+    const int blockWidth = x == width - 1 ? factor + remainder : factor;
+    const quint32 divisor = quint32(blockWidth * rows);
+    const quint32 half = divisor / 2;
+
+    quint32 sums[4] = { 0, 0, 0, 0 };
+    for (const quint16 *pixel = acc, *end = acc + blockWidth * 4; pixel != end; pixel += 4) {
+      sums[0] += pixel[0];
+      sums[1] += pixel[1];
+      sums[2] += pixel[2];
+      sums[3] += pixel[3];
+    }
+
+    for (int i = 0; i < 4; ++i)
+      dest[i] = uchar((sums[i] + half) / divisor);
+
+    acc += factor * 4;
+    dest += 4;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+QImage ImageScaler::boxReduce (const QImage &image, int xFactor, int yFactor) {
+  Q_ASSERT(image.depth() == 32);
+  Q_ASSERT(xFactor > 0 && xFactor <= MAX_BOX_FACTOR);
+  Q_ASSERT(yFactor > 0 && yFactor <= MAX_BOX_FACTOR);
+
+  static const AccumulateRow accumulateRow = ::getAccumulateRow();
+
+  const int width = image.width() / xFactor;
+  const int height = image.height() / yFactor;
+
+  QImage result(width, height, image.format());
+  if (result.isNull())
+    return result;
+
+  const int xRemainder = image.width() - width * xFactor;
+  const int yRemainder = image.height() - height * yFactor;
+  const int rowSize = image.width() * 4;
+
+  QVector<quint16> acc(rowSize);
+  for (int y = 0; y < height; ++y) {
+    const int rows = y == height - 1 ? yFactor + yRemainder : yFactor;
+
+    fill(acc.begin(), acc.end(), quint16(0));
+    for (int i = 0; i < rows; ++i)
+      accumulateRow(acc.data(), image.constScanLine(y * yFactor + i), rowSize);
+    ::reduceRow(acc.constData(), result.scanLine(y), width, xFactor, xRemainder, rows);
+  }
+
+  return result;
+}
+
+QImage ImageScaler::scaled (const QImage &image, const QSize &size, Qt::AspectRatioMode aspectRatioMode) {
+  if (image.isNull())
+    return image;
+
+  const QSize targetSize = image.size().scaled(size, aspectRatioMode);
+  if (targetSize.isEmpty())
+    return QImage();
+
+  QImage result = image.convertToFormat(
+    image.hasAlphaChannel() ? QImage::Format_ARGB32_Premultiplied : QImage::Format_RGB32
+  );
+
+  // Box stages while the image is at least twice too big.
+  for (;;) {
+    const int xFactor = qMin(result.width() / targetSize.width(), MAX_BOX_FACTOR);
+    const int yFactor = qMin(result.height() / targetSize.height(), MAX_BOX_FACTOR);
+    if (xFactor < 2 && yFactor < 2)
+      break;
+
+    result = boxReduce(result, qMax(xFactor, 1), qMax(yFactor, 1));
+    if (result.isNull())
+      return result;
+  }
+
+  return result.size() == targetSize
+    ? result
+    : result.scaled(targetSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+}
@@ -0,0 +1,42 @@
+/*
+ * ImageScaler.hpp
+ * Copyright (C) 2026  Belledonne Communications, Grenoble, France
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *  Created on: October 17, 2026
+ */
+
+#ifndef IMAGE_SCALER_H_
+#define IMAGE_SCALER_H_
+
+#include <QImage>
+
+// =============================================================================
+
+namespace ImageScaler {
+  // Same result as `QImage::scaled` with `Qt::SmoothTransformation`, but big
+  // reductions are first done by an integer box filter (SIMD when available),
+  // then the small intermediate image is smoothly scaled by Qt.
+  // Returns a `Format_ARGB32_Premultiplied` or `Format_RGB32` image.
+  QImage scaled (const QImage &image, const QSize &size, Qt::AspectRatioMode aspectRatioMode = Qt::KeepAspectRatio);
+
+  // Averages each block of `xFactor * yFactor` pixels. The remaining columns
+  // and rows are averaged in the last blocks, so no edge is cropped.
+  // `image` must be in a 32 bits format.
+  QImage boxReduce (const QImage &image, int xFactor, int yFactor);
+}
+
+#endif // IMAGE_SCALER_H_
@@ -41,12 +41,15 @@
 
 // This file was copied from Qt Extended 4.5
 
+#include <cstring>
+
 #include <QFile>
 #include <QImage>
 #include <QDataStream>
 #include <QBuffer>
 #include <QDateTime>
 #include <QtDebug>
+#include <QtEndian>
 #include <QTextCodec>
 
 #include "Utils.hpp"
@@ -98,6 +101,66 @@ QDataStream &operator>> (QDataStream &stream, ExifIfdHeader &header) {
   return stream;
 }
 
+// Helpers of the `readImageTag` fast path. The data is read in place.
+static inline quint16 readUInt16 (const uchar *data, bool littleEndian) {
+  return littleEndian ? qFromLittleEndian<quint16>(data) : qFromBigEndian<quint16>(data);
+}
+
+static inline quint32 readUInt32 (const uchar *data, bool littleEndian) {
+  return littleEndian ? qFromLittleEndian<quint32>(data) : qFromBigEndian<quint32>(data);
+}
+
+// Walks the entries of the first IFD of a TIFF header.
+static bool findImageIfdValue (const uchar *data, qint64 size, quint16 tag, quint32 &value) {
+  if (size < 8)
+    return false;
+
+  bool littleEndian;
+  if (data[0] == 'I' && data[1] == 'I')
+    littleEndian = true;
+  else if (data[0] == 'M' && data[1] == 'M')
+    littleEndian = false;
+  else
+    return false;
+
+  if (readUInt16(data + 2, littleEndian) != 0x002A)
+    return false;
+
+  const qint64 offset = readUInt32(data + 4, littleEndian);
+  if (offset + 2 > size)
+    return false;
+
+  const quint16 count = readUInt16(data + offset, littleEndian);
+  const uchar *entry = data + offset + 2;
+  if (offset + 2 + qint64(count) * 12 > size)
+    return false;
+
+  for (const uchar *end = entry + count * 12; entry != end; entry += 12) {
+    if (readUInt16(entry, littleEndian) != tag)
+      continue;
+
+    // Only one integer value, stored in the entry itself.
+    if (readUInt32(entry + 4, littleEndian) != 1)
+      return false;
+
+    switch (readUInt16(entry + 2, littleEndian)) {
+      case QExifValue::Byte:
+        value = entry[8];
+        return true;
+      case QExifValue::Short:
+        value = readUInt16(entry + 8, littleEndian);
+        return true;
+      case QExifValue::Long:
+        value = readUInt32(entry + 8, littleEndian);
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  return false;
+}
+
 class QExifValuePrivate : public QSharedData {
 public:
   QExifValuePrivate (quint16 t, int c)
@@ -876,6 +939,87 @@ bool QExifImageHeader::loadFromJpeg (QIODevice *device) {
   return false;
 }
 
+/*!
+    Reads the integer value of an image \a tag from a JPEG image with the given \a fileName,
+    without parsing the whole EXIF header. The file is mapped in memory and the read stops
+    at the requested tag.
+
+    Returns true if the tag was found with one Byte, Short or Long value and false otherwise.
+ */
+bool QExifImageHeader::readImageTag (const QString &fileName, ImageTag tag, quint32 &value) {
+  QFile file(fileName);
+  if (!file.open(QIODevice::ReadOnly))
+    return false;
+
+  const qint64 size = file.size();
+  const uchar *data = file.map(0, size);
+  if (data)
+    return readImageTag(data, size, tag, value);
+
+  // Not mappable, use the full parser.
+  QExifImageHeader header;
+  if (!header.loadFromJpeg(&file))
+    return false;
+
+  const QExifValue exifValue = header.value(tag);
+  if (exifValue.count() != 1)
+    return false;
+
+  switch (exifValue.type()) {
+    case QExifValue::Byte:
+      value = exifValue.toByte();
+      return true;
+    case QExifValue::Short:
+      value = exifValue.toShort();
+      return true;
+    case QExifValue::Long:
+      value = exifValue.toLong();
+      return true;
+    default:
+      return false;
+  }
+}
+
+/*!
+    Reads the integer value of an image \a tag from the JPEG image \a data of the given \a size.
+
+    \sa readImageTag()
+ */
+bool QExifImageHeader::readImageTag (const uchar *data, qint64 size, ImageTag tag, quint32 &value) {
+  if (size < 4 || data[0] != 0xFF || data[1] != 0xD8)
+    return false;
+
+  qint64 pos = 2;
+  while (pos + 4 <= size) {
+    if (data[pos] != 0xFF)
+      return false;
+
+    const uchar marker = data[pos + 1];
+
+    // Fill bytes.
+    if (marker == 0xFF) {
+      ++pos;
+      continue;
+    }
+
+    // End of image or start of scan: no metadata after.
+    if (marker == 0xD9 || marker == 0xDA)
+      return false;
+
+    const qint64 length = qFromBigEndian<quint16>(data + pos + 2);
+    if (length < 2 || pos + 2 + length > size)
+      return false;
+
+    // APP1 segment. Can be something else than EXIF, XMP for example.
+    if (marker == 0xE1 && length >= 8 && !memcmp(data + pos + 4, "Exif\0\0", 6))
+      return ::findImageIfdValue(data + pos + 10, length - 8, quint16(tag), value);
+
+    pos += 2 + length;
+  }
+
+  return false;
+}
+
 /*!
     Saves meta-data to a JPEG image with the given \a fileName.
 
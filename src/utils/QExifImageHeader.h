@@ -263,6 +263,8 @@ public:
 
   bool loadFromJpeg (const QString &fileName);
   bool loadFromJpeg (QIODevice *device);
+  static bool readImageTag (const QString &fileName, ImageTag tag, quint32 &value);
+  static bool readImageTag (const uchar *data, qint64 size, ImageTag tag, quint32 &value);
   bool saveToJpeg (const QString &fileName) const;
   bool saveToJpeg (QIODevice *device) const;
 
@@ -0,0 +1,538 @@
+/*
+ * SvgTemplate.cpp
+ * Copyright (C) 2026  Belledonne Communications, Grenoble, France
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *  Created on: October 17, 2026
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include <QDataStream>
+#include <QIODevice>
+#include <QVarLengthArray>
+#include <QtDebug>
+
+#include "SvgTemplate.hpp"
+
+// Must be incremented when the binary form changes.
+#define SVG_TEMPLATE_VERSION 1
+#define SVG_TEMPLATE_MAGIC 0x4C535654 // "LSVT"
+
+// Max attributes of one element.
+#define MAX_ATTRIBUTES 64
+
+using namespace std;
+
+// =============================================================================
+// Color names perfect hash. Built once for a list of names, then each
+// `color-<name>-*` class token is resolved with one hash and one comparison.
+// =============================================================================
+
+namespace {
+  class ColorNameTable {
+  public:
+    void build (const QStringList &names) {
+      mSource = names;
+      mNames.clear();
+      for (const auto &name : names)
+        mNames << name.toLatin1();
+
+      // Find a seed without collision. The table is at least twice bigger than
+      // the names list, so a few tries are enough.
+      for (int size = 16; ; size *= 2) {
+        if (size < 2 * mNames.count())
+          continue;
+
+        mMask = quint32(size - 1);
+        for (mSeed = 1; mSeed < 1024; ++mSeed)
+          if (tryFill(size))
+            return;
+      }
+    }
+
+    bool isBuiltFrom (const QStringList &names) const {
+      return !mBuckets.isEmpty() && mSource == names;
+    }
+
+    int indexOf (const char *name, int size) const {
+      const int index = mBuckets[int(hash(name, size, mSeed) & mMask)];
+      return index >= 0 && mNames[index].size() == size && !memcmp(mNames[index].constData(), name, size_t(size))
+        ? index
+        : -1;
+    }
+
+    int count () const {
+      return mNames.count();
+    }
+
+  private:
+    bool tryFill (int size) {
+      mBuckets.fill(-1, size);
+      for (int i = 0; i < mNames.count(); ++i) {
+        int &bucket = mBuckets[int(hash(mNames[i].constData(), mNames[i].size(), mSeed) & mMask)];
+        if (bucket != -1)
+          return false;
+        bucket = i;
+      }
+      return true;
+    }
+
+    // FNV-1a.
+    static quint32 hash (const char *name, int size, quint32 seed) {
+      quint32 value = 2166136261u ^ seed;
+      for (int i = 0; i < size; ++i)
+        value = (value ^ static_cast<uchar>(name[i])) * 16777619u;
+      return value;
+    }
+
+    QStringList mSource;
+    QVector<QByteArray> mNames;
+    QVector<int> mBuckets;
+    quint32 mSeed = 0;
+    quint32 mMask = 0;
+  };
+}
+
+// =============================================================================
+// Single pass tokenizer. The svg is copied as is, only the start tags with
+// color classes are rewritten.
+// =============================================================================
+
+namespace {
+  struct Span {
+    const char *data;
+    int size;
+
+    bool operator== (const char *other) const {
+      return int(strlen(other)) == size && !memcmp(data, other, size_t(size));
+    }
+  };
+
+  struct Attribute {
+    Span name;
+    Span value;
+    char quote;
+  };
+
+  enum ColorProperty {
+    Fill,
+    Stroke,
+    StyleFill,
+    StyleStroke,
+    ColorPropertyCount
+  };
+
+  // Known color index by property, or -1. `overridden` is set for the style properties
+  // even if the color is unknown: the previous style value is always dropped.
+  struct ColorDirectives {
+    int colors[ColorPropertyCount] = { -1, -1, -1, -1 };
+    bool overridden[ColorPropertyCount] = { false, false, false, false };
+  };
+
+  struct Tokenizer {
+    const ColorNameTable &table;
+    QVarLengthArray<int, 64> localIndexes; // Known color index => template color index.
+    QStringList colorNames;
+    QByteArray content;
+    QVector<SvgTemplate::Slot> slotList;
+  };
+}
+
+static inline bool isSpace (char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static inline const char *skipSpaces (const char *p, const char *end) {
+  while (p < end && ::isSpace(*p))
+    ++p;
+  return p;
+}
+
+static const char *findPattern (const char *p, const char *end, const char *pattern) {
+  const size_t size = strlen(pattern);
+  for (; p + size <= end; ++p) {
+    p = static_cast<const char *>(memchr(p, pattern[0], size_t(end - p)));
+    if (!p || p + size > end)
+      return nullptr;
+    if (!memcmp(p, pattern, size))
+      return p;
+  }
+  return nullptr;
+}
+
+// Parses a `color-<name>-(fill|stroke)` or `color-<name>-style-(fill|stroke)` token.
+static void parseClassToken (Tokenizer &tokenizer, Span token, ColorDirectives &directives) {
+  static const char prefix[] = "color-";
+  const int prefixSize = int(sizeof prefix) - 1;
+  if (token.size <= prefixSize || memcmp(token.data, prefix, prefixSize))
+    return;
+
+  const char *name = token.data + prefixSize;
+  const char *end = token.data + token.size;
+  const char *separator = static_cast<const char *>(memchr(name, '-', size_t(end - name)));
+  if (!separator || separator == name)
+    return;
+
+  const Span suffix{ separator + 1, int(end - separator - 1) };
+  ColorProperty property;
+  if (suffix == "fill")
+    property = Fill;
+  else if (suffix == "stroke")
+    property = Stroke;
+  else if (suffix == "style-fill")
+    property = StyleFill;
+  else if (suffix == "style-stroke")
+    property = StyleStroke;
+  else
+    return;
+
+  directives.overridden[property] = true;
+
+  const int nameSize = int(separator - name);
+  const int index = tokenizer.table.indexOf(name, nameSize);
+  if (Q_UNLIKELY(index == -1)) {
+    qWarning() << QStringLiteral("Color name `%1` does not exist.").arg(QString::fromLatin1(name, nameSize));
+    return;
+  }
+
+  directives.colors[property] = index;
+}
+
+static void appendSlot (Tokenizer &tokenizer, int knownIndex) {
+  int &localIndex = tokenizer.localIndexes[knownIndex];
+  if (localIndex == -1) {
+    localIndex = tokenizer.colorNames.count();
+    tokenizer.colorNames << QString(); // Set at the end.
+  }
+  tokenizer.slotList << SvgTemplate::Slot{ tokenizer.content.size(), localIndex };
+}
+
+static void appendAttribute (QByteArray &content, const Attribute &attribute) {
+  content.append(' ');
+  content.append(attribute.name.data, attribute.name.size);
+  content.append('=');
+  content.append(attribute.quote);
+  content.append(attribute.value.data, attribute.value.size);
+  content.append(attribute.quote);
+}
+
+// Writes `fill:<slot>;stroke:<slot>;` then the previous declarations
+// not overridden.
+static void appendStyle (Tokenizer &tokenizer, const ColorDirectives &directives, const Attribute *style) {
+  QByteArray &content = tokenizer.content;
+  content.append(" style=\"");
+
+  if (directives.colors[StyleFill] != -1) {
+    content.append("fill:");
+    ::appendSlot(tokenizer, directives.colors[StyleFill]);
+    content.append(';');
+  }
+  if (directives.colors[StyleStroke] != -1) {
+    content.append("stroke:");
+    ::appendSlot(tokenizer, directives.colors[StyleStroke]);
+    content.append(';');
+  }
+
+  if (style) {
+    const char *p = style->value.data;
+    const char *end = p + style->value.size;
+    while (p < end) {
+      const char *declarationEnd = static_cast<const char *>(memchr(p, ';', size_t(end - p)));
+      if (!declarationEnd)
+        declarationEnd = end;
+
+      const char *nameBegin = ::skipSpaces(p, declarationEnd);
+      const char *nameEnd = nameBegin;
+      while (nameEnd < declarationEnd && *nameEnd != ':' && !::isSpace(*nameEnd))
+        ++nameEnd;
+
+      const Span name{ nameBegin, int(nameEnd - nameBegin) };
+      if (
+        nameBegin != declarationEnd &&
+        !(directives.overridden[StyleFill] && name == "fill") &&
+        !(directives.overridden[StyleStroke] && name == "stroke")
+      ) {
+        content.append(p, int(declarationEnd - p));
+        content.append(';');
+      }
+
+      p = declarationEnd + 1;
+    }
+  }
+
+  content.append('"');
+}
+
+// `p` is on the `<` of a start tag. Returns the end of the tag or null on error.
+static const char *parseStartTag (Tokenizer &tokenizer, const char *p, const char *end) {
+  const char *tagBegin = p;
+  const char *nameEnd = ++p;
+  while (nameEnd < end && !::isSpace(*nameEnd) && *nameEnd != '>' && *nameEnd != '/')
+    ++nameEnd;
+
+  Attribute attributes[MAX_ATTRIBUTES];
+  int count = 0;
+  const Attribute *classAttribute = nullptr;
+
+  p = nameEnd;
+  for (;;) {
+    p = ::skipSpaces(p, end);
+    if (p >= end)
+      return nullptr;
+    if (*p == '>' || *p == '/')
+      break;
+
+    if (Q_UNLIKELY(count == MAX_ATTRIBUTES))
+      return nullptr;
+    Attribute &attribute = attributes[count++];
+
+    const char *attributeNameEnd = p;
+    while (attributeNameEnd < end && *attributeNameEnd != '=' && !::isSpace(*attributeNameEnd) && *attributeNameEnd != '>')
+      ++attributeNameEnd;
+    attribute.name = Span{ p, int(attributeNameEnd - p) };
+
+    p = ::skipSpaces(attributeNameEnd, end);
+    if (p >= end || *p != '=')
+      return nullptr;
+    p = ::skipSpaces(p + 1, end);
+    if (p >= end || (*p != '"' && *p != '\''))
+      return nullptr;
+
+    attribute.quote = *p++;
+    const char *valueEnd = static_cast<const char *>(memchr(p, attribute.quote, size_t(end - p)));
+    if (!valueEnd)
+      return nullptr;
+    attribute.value = Span{ p, int(valueEnd - p) };
+    p = valueEnd + 1;
+
+    if (attribute.name == "class")
+      classAttribute = &attribute;
+  }
+
+  const char *tagEnd = *p == '/' ? p + 1 : p;
+  if (tagEnd >= end || *tagEnd != '>')
+    return nullptr;
+  ++tagEnd;
+
+  // Find the color classes.
+  ColorDirectives directives;
+  bool hasDirectives = false;
+  if (classAttribute) {
+    const char *token = classAttribute->value.data;
+    const char *valueEnd = token + classAttribute->value.size;
+    while ((token = ::skipSpaces(token, valueEnd)) < valueEnd) {
+      const char *tokenEnd = token;
+      while (tokenEnd < valueEnd && !::isSpace(*tokenEnd))
+        ++tokenEnd;
+      ::parseClassToken(tokenizer, Span{ token, int(tokenEnd - token) }, directives);
+      token = tokenEnd;
+    }
+
+    for (int i = 0; i < ColorPropertyCount; ++i)
+      hasDirectives |= directives.overridden[i];
+  }
+
+  QByteArray &content = tokenizer.content;
+  if (!hasDirectives) {
+    content.append(tagBegin, int(tagEnd - tagBegin));
+    return tagEnd;
+  }
+
+  // Rewrite the tag.
+  content.append(tagBegin, int(nameEnd - tagBegin));
+
+  static const char *const attributeNames[] = { "fill", "stroke" };
+  for (int property : { Fill, Stroke })
+    if (directives.colors[property] != -1) {
+      content.append(' ');
+      content.append(attributeNames[property]);
+      content.append("=\"");
+      ::appendSlot(tokenizer, directives.colors[property]);
+      content.append('"');
+    }
+
+  const bool rewriteStyle = directives.overridden[StyleFill] || directives.overridden[StyleStroke];
+  const Attribute *style = nullptr;
+  for (int i = 0; i < count; ++i) {
+    const Attribute &attribute = attributes[i];
+    if (
+      (directives.colors[Fill] != -1 && attribute.name == "fill") ||
+      (directives.colors[Stroke] != -1 && attribute.name == "stroke")
+    )
+      continue;
+
+    if (rewriteStyle && attribute.name == "style") {
+      style = &attribute;
+      continue;
+    }
+
+    ::appendAttribute(content, attribute);
+  }
+
+  if (rewriteStyle)
+    ::appendStyle(tokenizer, directives, style);
+
+  content.append(p, int(tagEnd - p));
+  return tagEnd;
+}
+
+static const char *findEnd (const char *p, const char *end, const char *pattern) {
+  const char *found = ::findPattern(p, end, pattern);
+  return found ? found + strlen(pattern) : nullptr;
+}
+
+// Comments, processing instructions, doctype, cdata and end tags are copied as is.
+// Returns the end of the markup or null on error.
+static const char *parseMarkup (const char *p, const char *end) {
+  if (end - p >= 4 && !memcmp(p, "<!--", 4))
+    return ::findEnd(p + 4, end, "-->");
+  if (end - p >= 9 && !memcmp(p, "<![CDATA[", 9))
+    return ::findEnd(p + 9, end, "]]>");
+  if (p[1] == '?')
+    return ::findEnd(p + 2, end, "?>");
+
+  // End tag or doctype, maybe with an internal subset: `<!DOCTYPE svg [ <!ENTITY ...> ]>`.
+  const char *close = static_cast<const char *>(memchr(p, '>', size_t(end - p)));
+  const char *subset = p[1] == '!' ? static_cast<const char *>(memchr(p, '[', size_t(end - p))) : nullptr;
+  if (close && subset && subset < close)
+    return ::findEnd(subset, end, "]>");
+  return close ? close + 1 : nullptr;
+}
+
+static thread_local ColorNameTable colorNameTable;
+
+// -----------------------------------------------------------------------------
+
+QByteArray SvgTemplate::instantiate (const QVector<QByteArray> &colorValues) const {
+  Q_ASSERT(colorValues.count() == mColorNames.count());
+
+  int size = mContent.size();
+  for (const auto &slot : mSlots)
+    size += colorValues[slot.colorIndex].size();
+
+  QByteArray content;
+  content.reserve(size);
+
+  int offset = 0;
+  for (const auto &slot : mSlots) {
+    content.append(mContent.constData() + offset, slot.offset - offset);
+    content.append(colorValues[slot.colorIndex]);
+    offset = slot.offset;
+  }
+  content.append(mContent.constData() + offset, mContent.size() - offset);
+
+  return content;
+}
+
+QByteArray SvgTemplate::toData () const {
+  QByteArray data;
+  QDataStream stream(&data, QIODevice::WriteOnly);
+  stream.setVersion(QDataStream::Qt_5_0);
+
+  stream << quint32(SVG_TEMPLATE_MAGIC) << quint32(SVG_TEMPLATE_VERSION);
+  stream << mColorNames << mContent;
+  stream << quint32(mSlots.count());
+  for (const auto &slot : mSlots)
+    stream << qint32(slot.offset) << qint32(slot.colorIndex);
+
+  return data;
+}
+
+// -----------------------------------------------------------------------------
+
+SvgTemplate SvgTemplate::compile (const QByteArray &svg, const QStringList &knownColorNames) {
+  if (!::colorNameTable.isBuiltFrom(knownColorNames))
+    ::colorNameTable.build(knownColorNames);
+
+  Tokenizer tokenizer{ ::colorNameTable, QVarLengthArray<int, 64>(), QStringList(), QByteArray(), QVector<Slot>() };
+  tokenizer.localIndexes.resize(::colorNameTable.count());
+  fill(tokenizer.localIndexes.begin(), tokenizer.localIndexes.end(), -1);
+  // Color attributes are only added in a few elements.
+  tokenizer.content.reserve(svg.size() + svg.size() / 4 + 64);
+
+  const char *p = svg.constData();
+  const char *end = p + svg.size();
+  while (p < end) {
+    const char *tag = static_cast<const char *>(memchr(p, '<', size_t(end - p)));
+    if (!tag) {
+      tokenizer.content.append(p, int(end - p));
+      break;
+    }
+
+    tokenizer.content.append(p, int(tag - p));
+    if (tag + 1 >= end)
+      return SvgTemplate();
+
+    if (tag[1] == '!' || tag[1] == '?' || tag[1] == '/') {
+      p = ::parseMarkup(tag, end);
+      if (p)
+        tokenizer.content.append(tag, int(p - tag));
+    } else
+      p = ::parseStartTag(tokenizer, tag, end);
+
+    if (!p)
+      return SvgTemplate();
+  }
+
+  for (int i = 0; i < tokenizer.localIndexes.count(); ++i)
+    if (tokenizer.localIndexes[i] != -1)
+      tokenizer.colorNames[tokenizer.localIndexes[i]] = knownColorNames[i];
+
+  SvgTemplate svgTemplate;
+  svgTemplate.mContent = tokenizer.content;
+  svgTemplate.mColorNames = tokenizer.colorNames;
+  svgTemplate.mSlots = tokenizer.slotList;
+  return svgTemplate;
+}
+
+SvgTemplate SvgTemplate::compile (QIODevice &device, const QStringList &knownColorNames) {
+  return compile(device.readAll(), knownColorNames);
+}
+
+SvgTemplate SvgTemplate::fromData (const QByteArray &data) {
+  QDataStream stream(data);
+  stream.setVersion(QDataStream::Qt_5_0);
+
+  quint32 magic, version;
+  stream >> magic >> version;
+  if (magic != SVG_TEMPLATE_MAGIC || version != SVG_TEMPLATE_VERSION)
+    return SvgTemplate();
+
+  SvgTemplate svgTemplate;
+  quint32 count;
+  stream >> svgTemplate.mColorNames >> svgTemplate.mContent >> count;
+  if (stream.status() != QDataStream::Ok)
+    return SvgTemplate();
+
+  svgTemplate.mSlots.reserve(static_cast<int>(count));
+  for (quint32 i = 0; i < count; ++i) {
+    qint32 offset, colorIndex;
+    stream >> offset >> colorIndex;
+    if (
+      stream.status() != QDataStream::Ok ||
+      offset < (svgTemplate.mSlots.isEmpty() ? 0 : svgTemplate.mSlots.last().offset) ||
+      offset > svgTemplate.mContent.size() ||
+      colorIndex < 0 || colorIndex >= svgTemplate.mColorNames.count()
+    )
+      return SvgTemplate();
+
+    svgTemplate.mSlots << Slot{ offset, colorIndex };
+  }
+
+  return svgTemplate;
+}
@@ -0,0 +1,75 @@
+/*
+ * SvgTemplate.hpp
+ * Copyright (C) 2026  Belledonne Communications, Grenoble, France
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *  Created on: October 17, 2026
+ */
+
+#ifndef SVG_TEMPLATE_H_
+#define SVG_TEMPLATE_H_
+
+#include <QByteArray>
+#include <QStringList>
+#include <QVector>
+
+// =============================================================================
+
+class QIODevice;
+
+// Svg content where the `color-<name>-(fill|stroke)` and
+// `color-<name>-style-(fill|stroke)` classes are replaced by color slots.
+// Built once (at build time by the images compiler), then recolored
+// by a simple slot substitution.
+class SvgTemplate {
+public:
+  struct Slot {
+    int offset; // In the content, without the previous slots values.
+    int colorIndex; // In the color names list.
+  };
+
+  SvgTemplate () = default;
+
+  bool isNull () const {
+    return mContent.isEmpty();
+  }
+
+  // Color names used by the slots.
+  const QStringList &getColorNames () const {
+    return mColorNames;
+  }
+
+  // Returns a svg where each slot is replaced by the value of its color.
+  // `colorValues` must have the size of `getColorNames`.
+  QByteArray instantiate (const QVector<QByteArray> &colorValues) const;
+
+  // Binary form, see `fromData`.
+  QByteArray toData () const;
+
+  // Parses a svg file in one pass. Classes with an unknown color name are ignored.
+  // Returns a null template on error.
+  static SvgTemplate compile (const QByteArray &svg, const QStringList &knownColorNames);
+  static SvgTemplate compile (QIODevice &device, const QStringList &knownColorNames);
+
+  static SvgTemplate fromData (const QByteArray &data);
+
+private:
+  QByteArray mContent;
+  QStringList mColorNames;
+  QVector<Slot> mSlots;
+};
+
+#endif // SVG_TEMPLATE_H_
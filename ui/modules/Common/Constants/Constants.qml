@@ -9,6 +9,6 @@ QtObject {
   property int sizeMax: 999999
 
   property string imagesFormat: '.svg'
-  // property string imagesPath: 'image://internal/'
-  property string imagesPath: 'qrc:/assets/images/'
+  // Recolored and cached by `ImageProvider`.
+  property string imagesPath: 'image://internal/'
 }
@@ -1,4 +1,5 @@
 import QtQuick 2.7
+import QtQuick.Window 2.2
 
 // =============================================================================
 
@@ -22,6 +23,12 @@ Item {
 
       anchors.fill: parent
       fillMode: Image.PreserveAspectCrop
+
+      // Avoid the decoding of full size pictures for small items.
+      sourceSize {
+        height: item.height * Screen.devicePixelRatio
+        width: item.width * Screen.devicePixelRatio
+      }
     }
   }
 
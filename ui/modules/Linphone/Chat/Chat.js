@@ -71,6 +71,14 @@ function handleTextChanged () {
   container.proxyModel.compose()
 }
 
+function prefetchThumbnails () {
+  var first = chat.indexAt(0, chat.contentY)
+  var last = chat.indexAt(0, chat.contentY + chat.height - 1)
+  if (first !== -1 && last !== -1) {
+    container.proxyModel.prefetchThumbnails(first, last)
+  }
+}
+
 function sendMessage (text) {
   textArea.text = ''
   chat.bindToEnd = true
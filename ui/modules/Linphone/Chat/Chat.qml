@@ -53,7 +53,10 @@ Rectangle {
 
       Component.onCompleted: Logic.initView()
 
-      onContentYChanged: Logic.loadMoreEntries()
+      onContentYChanged: {
+        Logic.loadMoreEntries()
+        Logic.prefetchThumbnails()
+      }
       onMovementEnded: Logic.handleMovementEnded()
       onMovementStarted: Logic.handleMovementStarted()
 
@@ -60,6 +60,19 @@ TabContainer {
         }
       }
 
+      FormLine {
+        FormGroup {
+          label: qsTr('logsLevelsLabel')
+
+          TextField {
+            placeholderText: 'belle-sip=warning,qt=debug'
+            text: SettingsModel.logsLevels
+
+            onEditingFinished: SettingsModel.logsLevels = text
+          }
+        }
+      }
+
       FormEmptyLine {}
     }
 